@@ -0,0 +1,164 @@
+/*
+ * Compare the time taken by each engine to compute the same curve for two
+ * large timbres, and the time taken to update a curve as single partials
+ * change. Blocking only saves time once the mobile partials no longer fit in
+ * cache, so give a mobile timbre larger than the cache to measure its effect.
+ *
+ * Usage: disscalc-benchmarks [<stable count> [<mobile count> [<row count>]]]
+ */
+#include "disscalc/blocked-engine.hpp"
+#include "disscalc/dissonance.hpp"
+#include "disscalc/fft-engine.hpp"
+#include "disscalc/incremental-curve.hpp"
+#include "disscalc/partial.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using Model = disscalc::SetharesModel;
+
+// Create a timbre of random partials spread over the audible range.
+[[nodiscard]] static
+auto make_timbre(std::mt19937& rng, std::size_t partial_count)
+	-> std::vector<disscalc::Partial>
+{
+	std::uniform_real_distribution<double> frequency(50.0, 8000.0);
+	std::uniform_real_distribution<double> amplitude(0.001, 1.0);
+
+	std::vector<disscalc::Partial> partials;
+	for (std::size_t i = 0; i < partial_count; ++i)
+	{
+		partials.push_back({frequency(rng), amplitude(rng)});
+	}
+	return partials;
+}
+
+// Print how long `compute` took and how many pairs of partials it handled.
+static
+void run_benchmark(
+	std::string_view name,
+	std::size_t pair_count,
+	std::size_t row_count,
+	auto compute
+)
+{
+	using Clock = std::chrono::steady_clock;
+	auto const start = Clock::now();
+	compute();
+	std::chrono::duration<double> const elapsed = Clock::now() - start;
+
+	auto const pairs = static_cast<double>(pair_count)
+		* static_cast<double>(row_count);
+
+	std::cout << name << ": " << elapsed.count() << " s, "
+		<< pairs / elapsed.count() << " pairs/s\n";
+}
+
+int main(int argc, char** argv)
+{
+	std::size_t const stable_count = argc > 1
+		? std::strtoul(argv[1], nullptr, 10)
+		: 5000;
+	std::size_t const mobile_count = argc > 2
+		? std::strtoul(argv[2], nullptr, 10)
+		: stable_count;
+	std::size_t const row_count = argc > 3
+		? std::strtoul(argv[3], nullptr, 10)
+		: 64;
+
+	std::mt19937 rng(42);
+	auto const stable = make_timbre(rng, stable_count);
+	auto const mobile = make_timbre(rng, mobile_count);
+
+	std::vector<double> intervals;
+	for (std::size_t i = 0; i < row_count; ++i)
+	{
+		intervals.push_back(
+			1.0 + static_cast<double>(i) / static_cast<double>(row_count)
+		);
+	}
+	std::vector<double> exact(row_count);
+	std::vector<double> blocked(row_count);
+
+	auto const pair_count = stable.size() * mobile.size();
+	auto const mobile_kb = mobile_count * sizeof(disscalc::Partial) / 1000;
+	std::cout << stable_count << " stable and " << mobile_count
+		<< " mobile partials (" << mobile_kb << " kB), " << row_count
+		<< " rows, one thread\n";
+
+	run_benchmark("exact", pair_count, row_count, [&]
+	{
+		for (std::size_t i = 0; i < row_count; ++i)
+		{
+			exact[i] = disscalc::compute_dissonance<Model>(
+				stable,
+				mobile,
+				intervals[i]
+			);
+		}
+	});
+
+	run_benchmark(
+		"blocked",
+		pair_count,
+		row_count,
+		[&]
+		{
+			disscalc::compute_dissonance_curve_blocked<Model>(
+				stable,
+				mobile,
+				intervals,
+				blocked,
+				1
+			);
+		}
+	);
+	if (blocked != exact)
+	{
+		std::cerr << "blocked engine differs from exact engine\n";
+		return 1;
+	}
+
+	run_benchmark(
+		"fft",
+		pair_count,
+		row_count,
+		[&]
+		{
+			auto const curve = disscalc::compute_dissonance_curve_fft<Model>(
+				stable,
+				mobile,
+				intervals
+			);
+			(void)curve;
+		}
+	);
+
+	// Move each of a few stable partials, as an editor would.
+	auto const update_count = std::min<std::size_t>(16, stable.size());
+	auto const update_name =
+		std::to_string(update_count) + " incremental updates";
+	disscalc::IncrementalCurve<Model> curve(stable, mobile, intervals);
+	run_benchmark(
+		update_name,
+		2 * mobile.size(),
+		row_count * update_count,
+		[&]
+		{
+			for (std::size_t i = 0; i < update_count; ++i)
+			{
+				auto partial = stable[i];
+				partial.frequency *= 1.001;
+				curve.set_partial(disscalc::TimbreSide::stable, i, partial);
+			}
+		}
+	);
+}
@@ -0,0 +1,51 @@
+#include "disscalc/binary-io.hpp"
+
+#include <array>
+#include <bit>
+
+namespace disscalc
+{
+void write_little_endian(std::ostream& out, std::uint64_t value)
+{
+	std::array<char, 8> bytes;
+	for (auto& byte : bytes)
+	{
+		byte = static_cast<char>(value & 0xff);
+		value >>= 8;
+	}
+	out.write(bytes.data(), bytes.size());
+}
+
+void write_little_endian_double(std::ostream& out, double value)
+{
+	write_little_endian(out, std::bit_cast<std::uint64_t>(value));
+}
+
+[[nodiscard]]
+auto read_little_endian(std::istream& in) -> std::optional<std::uint64_t>
+{
+	std::array<char, 8> bytes;
+	if (!in.read(bytes.data(), bytes.size()))
+	{
+		return std::nullopt;
+	}
+
+	std::uint64_t value = 0;
+	for (auto byte = bytes.rbegin(); byte != bytes.rend(); ++byte)
+	{
+		value = (value << 8) | static_cast<unsigned char>(*byte);
+	}
+	return value;
+}
+
+[[nodiscard]]
+auto read_little_endian_double(std::istream& in) -> std::optional<double>
+{
+	auto const bits = read_little_endian(in);
+	if (!bits.has_value())
+	{
+		return std::nullopt;
+	}
+	return std::bit_cast<double>(*bits);
+}
+} // namespace disscalc
@@ -0,0 +1,25 @@
+#ifndef DISSCALC_BINARY_IO_HPP_INCLUDED
+#define DISSCALC_BINARY_IO_HPP_INCLUDED
+
+#include <cstdint>
+#include <iostream>
+#include <optional>
+
+namespace disscalc
+{
+/// Write `value` as eight little-endian bytes.
+void write_little_endian(std::ostream& out, std::uint64_t value);
+
+/// Write `value` as eight little-endian bytes of its IEEE 754 representation.
+void write_little_endian_double(std::ostream& out, double value);
+
+/// Read eight little-endian bytes, returning an empty optional on failure.
+[[nodiscard]]
+auto read_little_endian(std::istream& in) -> std::optional<std::uint64_t>;
+
+/// Read a double written by `write_little_endian_double`.
+[[nodiscard]]
+auto read_little_endian_double(std::istream& in) -> std::optional<double>;
+} // namespace disscalc
+
+#endif
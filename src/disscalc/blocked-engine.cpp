@@ -0,0 +1,99 @@
+#include "disscalc/blocked-engine.hpp"
+
+#include "disscalc/parallel.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+
+namespace disscalc
+{
+template <DissonanceModelPolicy Model>
+void compute_dissonance_curve_blocked(
+	std::span<Partial const> stable_partials,
+	std::span<Partial const> mobile_partials,
+	std::span<double const> intervals,
+	std::span<double> dissonances,
+	std::size_t thread_count
+) noexcept
+{
+	assert(intervals.size() == dissonances.size());
+
+	auto const tile_count = (intervals.size() + blocked_interval_tile - 1)
+		/ blocked_interval_tile;
+	parallel_for(tile_count, thread_count, [&](std::size_t tile) noexcept
+	{
+		auto const first = tile * blocked_interval_tile;
+		auto const count = std::min(
+			blocked_interval_tile,
+			intervals.size() - first
+		);
+		auto const tile_intervals = intervals.subspan(first, count);
+
+		std::array<double, blocked_interval_tile> sums{};
+		std::array<double, blocked_mobile_tile> weights;
+		for (auto const stable_partial : stable_partials)
+		{
+			for (
+				std::size_t first_mobile = 0;
+				first_mobile < mobile_partials.size();
+				first_mobile += blocked_mobile_tile
+			)
+			{
+				auto const mobile_tile = mobile_partials.subspan(
+					first_mobile,
+					std::min(
+						blocked_mobile_tile,
+						mobile_partials.size() - first_mobile
+					)
+				);
+				for (std::size_t m = 0; m < mobile_tile.size(); ++m)
+				{
+					weights[m] = Model::weight(
+						stable_partial.amplitude,
+						mobile_tile[m].amplitude
+					);
+				}
+
+				for (std::size_t r = 0; r < count; ++r)
+				{
+					// Summed in the same order as by `compute_dissonance`.
+					double sum = sums[r];
+					for (std::size_t m = 0; m < mobile_tile.size(); ++m)
+					{
+						sum += weights[m] * compute_roughness<Model>(
+							stable_partial.frequency,
+							mobile_tile[m].frequency * tile_intervals[r]
+						);
+					}
+					sums[r] = sum;
+				}
+			}
+		}
+
+		std::copy_n(sums.begin(), count, dissonances.begin() + first);
+	});
+}
+
+template void compute_dissonance_curve_blocked<SetharesModel>(
+	std::span<Partial const>,
+	std::span<Partial const>,
+	std::span<double const>,
+	std::span<double>,
+	std::size_t
+) noexcept;
+template void compute_dissonance_curve_blocked<ProductModel>(
+	std::span<Partial const>,
+	std::span<Partial const>,
+	std::span<double const>,
+	std::span<double>,
+	std::size_t
+) noexcept;
+template void compute_dissonance_curve_blocked<VassilakisModel>(
+	std::span<Partial const>,
+	std::span<Partial const>,
+	std::span<double const>,
+	std::span<double>,
+	std::size_t
+) noexcept;
+} // namespace disscalc
@@ -0,0 +1,44 @@
+#ifndef DISSCALC_BLOCKED_ENGINE_HPP_INCLUDED
+#define DISSCALC_BLOCKED_ENGINE_HPP_INCLUDED
+
+#include "disscalc/models.hpp"
+#include "disscalc/partial.hpp"
+
+#include <cstddef>
+#include <span>
+
+namespace disscalc
+{
+/// Number of intervals computed together by the blocked engine.
+constexpr std::size_t blocked_interval_tile = 32;
+
+/// Number of mobile partials kept in cache together by the blocked engine.
+constexpr std::size_t blocked_mobile_tile = 512;
+
+/** Compute the dissonance at each of `intervals` a tile at a time.
+ *
+ * Each stable partial is paired with a tile of mobile partials, whose weights
+ * are computed once and reused, along with the tile itself, for every
+ * interval in a tile of intervals. So the mobile partials are read from
+ * memory once per tile of intervals rather than once per interval.
+ *
+ * Each dissonance is summed in the same order as by `compute_dissonance`, so
+ * the results are exactly the same. Tiles of intervals are computed in
+ * parallel. Instantiations exist for every model in `DissonanceModel`.
+ *
+ * @param dissonances receives the dissonance at each interval, and must have
+ * the same size as `intervals`.
+ *
+ * @param thread_count the maximum number of threads, as for `parallel_for`.
+ */
+template <DissonanceModelPolicy Model>
+void compute_dissonance_curve_blocked(
+	std::span<Partial const> stable_partials,
+	std::span<Partial const> mobile_partials,
+	std::span<double const> intervals,
+	std::span<double> dissonances,
+	std::size_t thread_count
+) noexcept;
+} // namespace disscalc
+
+#endif
@@ -0,0 +1,118 @@
+#ifndef DISSCALC_BOUNDED_QUEUE_HPP_INCLUDED
+#define DISSCALC_BOUNDED_QUEUE_HPP_INCLUDED
+
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace disscalc
+{
+/** Queue passing items between threads, holding at most a fixed number.
+ *
+ * Producers block while the queue is full, so a fast producer cannot use
+ * unbounded memory ahead of a slow consumer. Once the queue is closed, no more
+ * items may be pushed, and consumers receive the remaining items followed by
+ * an empty optional.
+ */
+template <typename T>
+class BoundedQueue
+{
+public:
+	explicit BoundedQueue(std::size_t capacity)
+		: capacity_(capacity)
+	{
+		assert(capacity > 0);
+	}
+
+	/** Add an item, waiting while the queue is full.
+	 *
+	 * @return false if the queue was closed, in which case the item is
+	 * discarded.
+	 */
+	bool push(T item)
+	{
+		std::unique_lock lock(mutex_);
+		not_full_.wait(lock, [&]
+		{
+			return closed_ || items_.size() < capacity_;
+		});
+		if (closed_)
+		{
+			return false;
+		}
+
+		items_.push_back(std::move(item));
+		not_empty_.notify_one();
+		return true;
+	}
+
+	/** Remove the oldest item, waiting while the queue is empty.
+	 *
+	 * @return the item, or an empty optional if the queue is closed and
+	 * empty.
+	 */
+	[[nodiscard]]
+	auto pop(void) -> std::optional<T>
+	{
+		std::unique_lock lock(mutex_);
+		not_empty_.wait(lock, [&]
+		{
+			return closed_ || !items_.empty();
+		});
+		if (items_.empty())
+		{
+			return std::nullopt;
+		}
+
+		auto item = std::move(items_.front());
+		items_.pop_front();
+		not_full_.notify_one();
+		return item;
+	}
+
+	/// Stop accepting items and wake every waiting thread.
+	void close(void)
+	{
+		std::scoped_lock lock(mutex_);
+		closed_ = true;
+		not_full_.notify_all();
+		not_empty_.notify_all();
+	}
+
+private:
+	std::size_t capacity_;
+
+	std::mutex mutex_;
+	std::condition_variable not_full_;
+	std::condition_variable not_empty_;
+	std::deque<T> items_;
+	bool closed_ = false;
+};
+
+/// Closes a queue when destroyed, even if an exception is thrown.
+template <typename T>
+class QueueCloser
+{
+public:
+	explicit QueueCloser(BoundedQueue<T>& queue) noexcept
+		: queue_(queue)
+	{}
+
+	QueueCloser(QueueCloser const&) = delete;
+	QueueCloser& operator=(QueueCloser const&) = delete;
+
+	~QueueCloser(void)
+	{
+		queue_.close();
+	}
+
+private:
+	BoundedQueue<T>& queue_;
+};
+} // namespace disscalc
+
+#endif
@@ -0,0 +1,225 @@
+#include "disscalc/chebyshev-curve.hpp"
+
+#include "disscalc/binary-io.hpp"
+
+#include <array>
+#include <limits>
+#include <string_view>
+
+namespace disscalc
+{
+[[nodiscard]]
+auto fit_chebyshev_coefficients(std::span<double const> values)
+	-> std::vector<double>
+{
+	auto const n = static_cast<double>(values.size());
+
+	std::vector<double> coefficients(values.size());
+	for (std::size_t j = 0; j < values.size(); ++j)
+	{
+		double sum = 0.0;
+		for (std::size_t k = 0; k < values.size(); ++k)
+		{
+			sum += values[k] * std::cos(
+				std::numbers::pi
+					* static_cast<double>(j)
+					* (static_cast<double>(k) + 0.5)
+					/ n
+			);
+		}
+		coefficients[j] = 2.0 * sum / n;
+	}
+	coefficients.front() *= 0.5;
+
+	return coefficients;
+}
+
+[[nodiscard]]
+double evaluate_chebyshev(
+	std::span<double const> coefficients,
+	double t
+) noexcept
+{
+	// Clenshaw's recurrence.
+	double b1 = 0.0;
+	double b2 = 0.0;
+	for (auto c = coefficients.rbegin(); c + 1 < coefficients.rend(); ++c)
+	{
+		auto const b0 = *c + 2.0 * t * b1 - b2;
+		b2 = b1;
+		b1 = b0;
+	}
+	return coefficients.front() + t * b1 - b2;
+}
+
+[[nodiscard]]
+bool segments_cover_range(std::span<ChebyshevSegment const> segments) noexcept
+{
+	// Positions are measured in cells of the finest possible grid.
+	constexpr auto cell_count = std::uint64_t(1) << max_chebyshev_depth;
+
+	std::uint64_t position = 0;
+	for (auto const& segment : segments)
+	{
+		if (
+			segment.depth > max_chebyshev_depth
+			|| segment.coefficients.empty()
+			|| position >= cell_count
+		)
+		{
+			return false;
+		}
+
+		auto const size = cell_count >> segment.depth;
+		if (position % size != 0)
+		{
+			return false;
+		}
+		position += size;
+	}
+	return position == cell_count;
+}
+
+ChebyshevCurve::ChebyshevCurve(
+	double first,
+	double last,
+	std::vector<ChebyshevSegment> segments
+)
+	: first_(first),
+	last_(last),
+	segments_(std::move(segments))
+{
+	assert(first_ < last_);
+	assert(segments_cover_range(segments_));
+
+	for (auto const& segment : segments_)
+	{
+		table_depth_ = std::max(table_depth_, segment.depth);
+		error_bound_ = std::max(error_bound_, segment.error);
+	}
+
+	table_.reserve(std::size_t(1) << table_depth_);
+	centers_.reserve(segments_.size());
+	half_widths_.reserve(segments_.size());
+
+	double left = first_;
+	for (std::size_t i = 0; i < segments_.size(); ++i)
+	{
+		auto const depth = segments_[i].depth;
+		auto const width = (last_ - first_)
+			/ std::ldexp(1.0, static_cast<int>(depth));
+		centers_.push_back(left + 0.5 * width);
+		half_widths_.push_back(0.5 * width);
+		left += width;
+
+		table_.insert(
+			table_.end(),
+			std::size_t(1) << (table_depth_ - depth),
+			static_cast<std::uint32_t>(i)
+		);
+	}
+}
+
+[[nodiscard]]
+double ChebyshevCurve::operator()(double x) const noexcept
+{
+	x = std::clamp(x, first_, last_);
+
+	auto const cell_count = static_cast<double>(table_.size());
+	auto const cell = std::min(
+		static_cast<std::size_t>((x - first_) / (last_ - first_) * cell_count),
+		table_.size() - 1
+	);
+	auto const i = table_[cell];
+
+	auto const t = std::clamp((x - centers_[i]) / half_widths_[i], -1.0, 1.0);
+	return evaluate_chebyshev(segments_[i].coefficients, t);
+}
+
+constexpr std::string_view chebyshev_magic = "DISSCHEB";
+
+void write_chebyshev_curve(std::ostream& out, ChebyshevCurve const& curve)
+{
+	out.write(chebyshev_magic.data(), chebyshev_magic.size());
+	write_little_endian_double(out, curve.first());
+	write_little_endian_double(out, curve.last());
+	write_little_endian(out, curve.segments().size());
+
+	for (auto const& segment : curve.segments())
+	{
+		out.put(static_cast<char>(segment.depth));
+		out.put(static_cast<char>(segment.coefficients.size()));
+		write_little_endian_double(out, segment.error);
+		for (auto const c : segment.coefficients)
+		{
+			write_little_endian_double(out, c);
+		}
+	}
+}
+
+[[nodiscard]]
+auto read_chebyshev_curve(std::istream& in) -> std::optional<ChebyshevCurve>
+{
+	std::array<char, chebyshev_magic.size()> magic;
+	if (
+		!in.read(magic.data(), magic.size())
+		|| std::string_view(magic.data(), magic.size()) != chebyshev_magic
+	)
+	{
+		return std::nullopt;
+	}
+
+	auto const first = read_little_endian_double(in);
+	auto const last = read_little_endian_double(in);
+	auto const segment_count = read_little_endian(in);
+	if (
+		!first.has_value()
+		|| !last.has_value()
+		|| !segment_count.has_value()
+		|| !(*first < *last)
+		|| !std::isfinite(*last - *first)
+		|| *segment_count > std::uint64_t(1) << max_chebyshev_depth
+	)
+	{
+		return std::nullopt;
+	}
+
+	std::vector<ChebyshevSegment> segments(*segment_count);
+	for (auto& segment : segments)
+	{
+		auto const depth = in.get();
+		auto const coefficient_count = in.get();
+		auto const error = read_little_endian_double(in);
+		if (
+			!error.has_value()
+			|| coefficient_count <= 0
+			|| static_cast<std::size_t>(coefficient_count)
+				> max_chebyshev_degree + 1
+		)
+		{
+			return std::nullopt;
+		}
+
+		segment.depth = static_cast<unsigned>(depth);
+		segment.error = *error;
+		segment.coefficients.resize(
+			static_cast<std::size_t>(coefficient_count)
+		);
+		for (auto& c : segment.coefficients)
+		{
+			auto const value = read_little_endian_double(in);
+			if (!value.has_value())
+			{
+				return std::nullopt;
+			}
+			c = *value;
+		}
+	}
+
+	if (!segments_cover_range(segments))
+	{
+		return std::nullopt;
+	}
+	return ChebyshevCurve(*first, *last, std::move(segments));
+}
+} // namespace disscalc
@@ -0,0 +1,282 @@
+#ifndef DISSCALC_CHEBYSHEV_CURVE_HPP_INCLUDED
+#define DISSCALC_CHEBYSHEV_CURVE_HPP_INCLUDED
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <numbers>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace disscalc
+{
+/// Greatest number of times the range of a curve may be halved.
+constexpr unsigned max_chebyshev_depth = 20;
+
+/// Greatest degree of the polynomial on each segment of a curve.
+constexpr std::size_t max_chebyshev_degree = 32;
+
+/// Number of points between neighboring nodes at which a fit is checked.
+constexpr std::size_t chebyshev_checks_between_nodes = 7;
+
+/// Chebyshev series approximating a function on one segment of a curve.
+struct ChebyshevSegment
+{
+	/** Number of times the range of the curve is halved to get the segment.
+	 *
+	 * Segments are stored in order, so their positions follow from their
+	 * depths.
+	 */
+	unsigned depth;
+
+	/// Coefficients of the series, with at least one.
+	std::vector<double> coefficients;
+
+	/// Largest error of the series measured when it was fitted.
+	double error;
+};
+
+/** Get the Chebyshev coefficients of the polynomial interpolating `values`.
+ *
+ * The value at index `k` is that of the function at the Chebyshev node
+ * `cos(pi (k + 1/2) / n)` in `[-1, 1]`, where `n` is the number of values.
+ */
+[[nodiscard]]
+auto fit_chebyshev_coefficients(std::span<double const> values)
+	-> std::vector<double>;
+
+/// Evaluate a Chebyshev series at `t` in `[-1, 1]`.
+[[nodiscard]]
+double evaluate_chebyshev(
+	std::span<double const> coefficients,
+	double t
+) noexcept;
+
+/** Piecewise Chebyshev approximation of a function on a closed range.
+ *
+ * The range is split into segments by repeatedly halving it, so every segment
+ * lies on a cell of a uniform grid as fine as the smallest segment. A table
+ * maps each cell to its segment, so a query takes constant time.
+ */
+class ChebyshevCurve
+{
+public:
+	/** Create a curve from its segments.
+	 *
+	 * The segments must exactly cover `[first, last]` in order, as checked by
+	 * `segments_cover_range`.
+	 */
+	ChebyshevCurve(
+		double first,
+		double last,
+		std::vector<ChebyshevSegment> segments
+	);
+
+	/// Evaluate the curve at `x`, which is clamped to the range of the curve.
+	[[nodiscard]]
+	double operator()(double x) const noexcept;
+
+	[[nodiscard]]
+	double first(void) const noexcept
+	{
+		return first_;
+	}
+
+	[[nodiscard]]
+	double last(void) const noexcept
+	{
+		return last_;
+	}
+
+	[[nodiscard]]
+	auto segments(void) const noexcept -> std::vector<ChebyshevSegment> const&
+	{
+		return segments_;
+	}
+
+	/// Largest error of any segment measured when the curve was fitted.
+	[[nodiscard]]
+	double error_bound(void) const noexcept
+	{
+		return error_bound_;
+	}
+
+private:
+	double first_;
+	double last_;
+	std::vector<ChebyshevSegment> segments_;
+	double error_bound_ = 0.0;
+
+	// Depth of the grid of the lookup table.
+	unsigned table_depth_ = 0;
+
+	// Index of the segment holding each cell of the grid.
+	std::vector<std::uint32_t> table_;
+
+	// Center and half-width of each segment, in the same order.
+	std::vector<double> centers_;
+	std::vector<double> half_widths_;
+};
+
+/// Indicate whether segments of the given depths exactly cover a range.
+[[nodiscard]]
+bool segments_cover_range(std::span<ChebyshevSegment const> segments) noexcept;
+
+/** Fit a piecewise Chebyshev curve to `func` on `[first, last]`.
+ *
+ * A segment is accepted when a bound on the error of its series is within
+ * `tolerance`, and otherwise halved, down to `max_chebyshev_depth`. The bound
+ * comes from the error at the nodes and at points between them, assuming the
+ * error changes no faster between those points than it does anywhere between
+ * neighboring ones. Trailing coefficients are then dropped while the sum of
+ * their magnitudes keeps the error within `tolerance`.
+ *
+ * A segment at the greatest depth is accepted even if its error is not within
+ * `tolerance`, so callers should compare `error_bound()` with `tolerance`.
+ *
+ * @param degree the degree of the series on each segment, at most
+ * `max_chebyshev_degree`.
+ */
+[[nodiscard]]
+auto fit_chebyshev_curve(
+	double first,
+	double last,
+	double tolerance,
+	std::size_t degree,
+	std::invocable<double> auto func
+) -> ChebyshevCurve
+{
+	assert(first < last);
+	assert(degree <= max_chebyshev_degree);
+
+	auto const node_count = degree + 1;
+	std::vector<double> node_positions(node_count);
+	for (std::size_t k = 0; k < node_count; ++k)
+	{
+		node_positions[k] = std::cos(
+			std::numbers::pi
+				* (static_cast<double>(k) + 0.5)
+				/ static_cast<double>(node_count)
+		);
+	}
+
+	/*
+	 * Check the error at both ends, at every node and at evenly spaced points
+	 * between them, in decreasing order.
+	 */
+	std::vector<double> check_positions = {1.0};
+	auto const add_checks = [&](double from, double to)
+	{
+		for (std::size_t j = 1; j <= chebyshev_checks_between_nodes; ++j)
+		{
+			auto const fraction = static_cast<double>(j)
+				/ static_cast<double>(chebyshev_checks_between_nodes + 1);
+			check_positions.push_back(from + fraction * (to - from));
+		}
+		check_positions.push_back(to);
+	};
+	for (std::size_t k = 0; k < node_count; ++k)
+	{
+		add_checks(k == 0 ? 1.0 : node_positions[k - 1], node_positions[k]);
+	}
+	add_checks(node_positions.back(), -1.0);
+
+	std::vector<ChebyshevSegment> segments;
+	std::vector<double> values(node_count);
+	std::vector<double> errors(check_positions.size());
+
+	// Fit the segment at the given depth and position, counting from zero.
+	auto const fit_segment = [&](
+		auto const& self,
+		unsigned depth,
+		std::uint64_t position
+	) -> void
+	{
+		auto const width = (last - first)
+			/ std::ldexp(1.0, static_cast<int>(depth));
+		auto const left = first + width * static_cast<double>(position);
+		auto const center = left + 0.5 * width;
+		auto const half_width = 0.5 * width;
+
+		for (std::size_t k = 0; k < node_count; ++k)
+		{
+			values[k] = func(center + half_width * node_positions[k]);
+		}
+		auto coefficients = fit_chebyshev_coefficients(values);
+
+		for (std::size_t k = 0; k < check_positions.size(); ++k)
+		{
+			auto const t = check_positions[k];
+			errors[k] = evaluate_chebyshev(coefficients, t)
+				- func(center + half_width * t);
+		}
+
+		/*
+		 * The error may peak between checked points, such as at a kink in
+		 * `func`, so it is bounded there by assuming it changes no faster than
+		 * it does between any two neighboring points.
+		 */
+		double slope = 0.0;
+		for (std::size_t k = 0; k + 1 < errors.size(); ++k)
+		{
+			slope = std::max(
+				slope,
+				std::abs(errors[k + 1] - errors[k])
+					/ (check_positions[k] - check_positions[k + 1])
+			);
+		}
+		double error = 0.0;
+		for (std::size_t k = 0; k + 1 < errors.size(); ++k)
+		{
+			auto const gap = check_positions[k] - check_positions[k + 1];
+			error = std::max(
+				error,
+				0.5 * (std::abs(errors[k]) + std::abs(errors[k + 1]))
+					+ 0.5 * slope * gap
+			);
+		}
+
+		if (!(error <= tolerance) && depth < max_chebyshev_depth)
+		{
+			self(self, depth + 1, 2 * position);
+			self(self, depth + 1, 2 * position + 1);
+			return;
+		}
+
+		while (
+			coefficients.size() > 1
+			&& error + std::abs(coefficients.back()) <= tolerance
+		)
+		{
+			error += std::abs(coefficients.back());
+			coefficients.pop_back();
+		}
+		segments.push_back({depth, std::move(coefficients), error});
+	};
+	fit_segment(fit_segment, 0, 0);
+
+	return ChebyshevCurve(first, last, std::move(segments));
+}
+
+/** Write a curve in a compact binary format.
+ *
+ * Every number is little-endian. The format starts with the eight bytes
+ * "DISSCHEB", followed by the range of the curve as two 64-bit IEEE 754
+ * floating point numbers and the number of segments as a 64-bit unsigned
+ * integer. Each segment is then written as a byte holding its depth, a byte
+ * holding its number of coefficients, its measured error and its
+ * coefficients, all as 64-bit floating point numbers.
+ */
+void write_chebyshev_curve(std::ostream& out, ChebyshevCurve const& curve);
+
+/// Read a curve written by `write_chebyshev_curve`.
+[[nodiscard]]
+auto read_chebyshev_curve(std::istream& in) -> std::optional<ChebyshevCurve>;
+} // namespace disscalc
+
+#endif
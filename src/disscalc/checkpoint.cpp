@@ -0,0 +1,142 @@
+#include "disscalc/checkpoint.hpp"
+
+#include <bit>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace disscalc
+{
+// First line of every checkpoint file, including the format version.
+constexpr std::string_view checkpoint_header = "disscalc-checkpoint 1";
+
+// Add a byte to a 64-bit FNV-1a hash.
+static
+void add_byte(std::uint64_t& hash, unsigned char byte) noexcept
+{
+	hash ^= byte;
+	hash *= 0x100000001B3;
+}
+
+// Add the bytes of `value` to a hash, least significant first.
+static
+void add_word(std::uint64_t& hash, std::uint64_t value) noexcept
+{
+	for (int i = 0; i < 8; ++i)
+	{
+		add_byte(hash, static_cast<unsigned char>(value >> (8 * i)));
+	}
+}
+
+// Add the number of partials, then each of them, to a hash.
+static
+void add_partials(
+	std::uint64_t& hash,
+	std::span<Partial const> partials
+) noexcept
+{
+	add_word(hash, partials.size());
+	for (auto const partial : partials)
+	{
+		add_word(hash, std::bit_cast<std::uint64_t>(partial.frequency));
+		add_word(hash, std::bit_cast<std::uint64_t>(partial.amplitude));
+	}
+}
+
+[[nodiscard]]
+std::uint64_t fingerprint_arguments(std::span<char const* const> args) noexcept
+{
+	// 64-bit FNV-1a, with a zero byte after each argument.
+	std::uint64_t hash = 0xCBF29CE484222325;
+	for (auto const arg : args.subspan(args.empty() ? 0 : 1))
+	{
+		for (auto const c : std::string_view(arg))
+		{
+			add_byte(hash, static_cast<unsigned char>(c));
+		}
+		add_byte(hash, 0);
+	}
+	return hash;
+}
+
+[[nodiscard]]
+std::uint64_t fingerprint_inputs(
+	std::uint64_t fingerprint,
+	std::span<Partial const> stable,
+	std::span<Partial const> mobile,
+	std::span<double const> extra_values
+) noexcept
+{
+	add_partials(fingerprint, stable);
+	add_partials(fingerprint, mobile);
+	add_word(fingerprint, extra_values.size());
+	for (auto const x : extra_values)
+	{
+		add_word(fingerprint, std::bit_cast<std::uint64_t>(x));
+	}
+	return fingerprint;
+}
+
+[[nodiscard]]
+auto read_checkpoint(std::istream& in) -> std::optional<Checkpoint>
+{
+	std::string header;
+	if (!std::getline(in, header) || header != checkpoint_header)
+	{
+		return std::nullopt;
+	}
+
+	Checkpoint checkpoint;
+	std::string fingerprint_key;
+	std::string rows_key;
+	std::string size_key;
+	in >> fingerprint_key >> std::hex >> checkpoint.fingerprint >> std::dec
+		>> rows_key >> checkpoint.completed_rows
+		>> size_key >> checkpoint.output_size;
+	if (
+		!in
+		|| fingerprint_key != "fingerprint"
+		|| rows_key != "rows"
+		|| size_key != "bytes"
+	)
+	{
+		return std::nullopt;
+	}
+
+	return checkpoint;
+}
+
+void write_checkpoint(std::ostream& out, Checkpoint const& checkpoint)
+{
+	out << checkpoint_header << '\n'
+		<< "fingerprint " << std::hex << checkpoint.fingerprint << std::dec
+		<< '\n'
+		<< "rows " << checkpoint.completed_rows << '\n'
+		<< "bytes " << checkpoint.output_size << '\n';
+}
+
+[[nodiscard]]
+bool save_checkpoint(
+	std::filesystem::path const& path,
+	Checkpoint const& checkpoint
+)
+{
+	auto temporary_path = path;
+	temporary_path += ".tmp";
+
+	{
+		std::ofstream temporary(temporary_path, std::ios::trunc);
+		write_checkpoint(temporary, checkpoint);
+		temporary.flush();
+		if (!temporary)
+		{
+			return false;
+		}
+	}
+
+	std::error_code error;
+	std::filesystem::rename(temporary_path, path, error);
+	return !error;
+}
+} // namespace disscalc
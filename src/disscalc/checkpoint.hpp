@@ -0,0 +1,70 @@
+#ifndef DISSCALC_CHECKPOINT_HPP_INCLUDED
+#define DISSCALC_CHECKPOINT_HPP_INCLUDED
+
+#include "disscalc/partial.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <span>
+
+namespace disscalc
+{
+/// Progress of a sweep whose output is written to a file.
+struct Checkpoint
+{
+	/// Identifies the options of the sweep, so a resume uses the same ones.
+	std::uint64_t fingerprint;
+
+	/// Number of rows completely written, counted from the first row.
+	std::size_t completed_rows;
+
+	/// Size of the output file after writing those rows.
+	std::uintmax_t output_size;
+};
+
+/** Compute a fingerprint of command-line arguments.
+ *
+ * The program name is not included, so the same sweep may be resumed through
+ * a different path to the program.
+ */
+[[nodiscard]]
+std::uint64_t fingerprint_arguments(std::span<char const* const> args) noexcept;
+
+/** Extend a fingerprint with the partials and extra intervals of a sweep.
+ *
+ * Arguments such as `--extra-file` name files whose contents may change
+ * between runs, so the values read from them are fingerprinted as well.
+ */
+[[nodiscard]]
+std::uint64_t fingerprint_inputs(
+	std::uint64_t fingerprint,
+	std::span<Partial const> stable,
+	std::span<Partial const> mobile,
+	std::span<double const> extra_values
+) noexcept;
+
+/// Read a checkpoint, returning an empty optional if it is malformed.
+[[nodiscard]]
+auto read_checkpoint(std::istream& in) -> std::optional<Checkpoint>;
+
+/// Write a checkpoint in the format read by `read_checkpoint`.
+void write_checkpoint(std::ostream& out, Checkpoint const& checkpoint);
+
+/** Replace the checkpoint file at `path` atomically.
+ *
+ * The checkpoint is written to a temporary file next to `path`, which is then
+ * renamed, so an interruption never leaves a partially written checkpoint.
+ *
+ * @return whether the checkpoint was saved.
+ */
+[[nodiscard]]
+bool save_checkpoint(
+	std::filesystem::path const& path,
+	Checkpoint const& checkpoint
+);
+} // namespace disscalc
+
+#endif
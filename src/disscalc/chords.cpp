@@ -0,0 +1,216 @@
+#include "disscalc/chords.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+
+namespace disscalc
+{
+// Try to parse all of `str` as a positive whole number.
+[[nodiscard]] static
+auto parse_whole_number(std::string_view str) noexcept
+	-> std::optional<std::uint64_t>
+{
+	std::uint64_t value;
+	auto const [end, error] = std::from_chars(
+		str.data(),
+		str.data() + str.size(),
+		value
+	);
+	if (error != std::errc() || end != str.data() + str.size() || value == 0)
+	{
+		return std::nullopt;
+	}
+	return value;
+}
+
+[[nodiscard]]
+auto parse_chord_pitch(std::string_view token) noexcept
+	-> std::optional<ChordPitch>
+{
+	// Cents are distinguished from ratios by containing a period.
+	if (token.find('.') != std::string_view::npos)
+	{
+		double cents;
+		auto const [end, error] = std::from_chars(
+			token.data(),
+			token.data() + token.size(),
+			cents
+		);
+		if (error != std::errc() || end != token.data() + token.size())
+		{
+			return std::nullopt;
+		}
+		return ChordPitch{std::exp2(cents / 1200.0), std::nullopt};
+	}
+
+	auto const slash = token.find('/');
+	auto const numerator = parse_whole_number(token.substr(0, slash));
+	auto const denominator = slash == std::string_view::npos
+		? std::optional<std::uint64_t>(1)
+		: parse_whole_number(token.substr(slash + 1));
+	if (!numerator.has_value() || !denominator.has_value())
+	{
+		return std::nullopt;
+	}
+
+	auto const divisor = std::gcd(*numerator, *denominator);
+	Fraction const fraction{*numerator / divisor, *denominator / divisor};
+	return ChordPitch{
+		static_cast<double>(fraction.numerator)
+			/ static_cast<double>(fraction.denominator),
+		fraction
+	};
+}
+
+[[nodiscard]]
+auto read_chords(std::istream& in) -> ChordList
+{
+	constexpr std::string_view whitespace = " \t\r";
+
+	ChordList list;
+	std::string line;
+	std::size_t line_number = 0;
+	while (std::getline(in, line))
+	{
+		++line_number;
+
+		std::string_view text = line;
+		auto const first = text.find_first_not_of(whitespace);
+		if (first == std::string_view::npos || text[first] == '#')
+		{
+			continue;
+		}
+		auto const last = text.find_last_not_of(whitespace);
+		text = text.substr(first, last + 1 - first);
+
+		Chord chord{std::string(text), {}};
+		while (!text.empty())
+		{
+			auto const end = std::min(
+				text.find_first_of(whitespace),
+				text.size()
+			);
+			auto const pitch = parse_chord_pitch(text.substr(0, end));
+			if (!pitch.has_value())
+			{
+				list.error_line = line_number;
+				return list;
+			}
+			chord.pitches.push_back(*pitch);
+
+			text.remove_prefix(end);
+			text.remove_prefix(
+				std::min(text.find_first_not_of(whitespace), text.size())
+			);
+		}
+
+		if (chord.pitches.size() < 2)
+		{
+			list.error_line = line_number;
+			return list;
+		}
+		list.chords.push_back(std::move(chord));
+	}
+
+	return list;
+}
+
+/*
+ * Key identifying an interval exactly. For a fraction, the denominator is
+ * nonzero, and otherwise the numerator holds the bits of the ratio.
+ */
+struct IntervalKey
+{
+	Fraction value;
+
+	[[nodiscard]]
+	friend bool operator==(IntervalKey, IntervalKey) noexcept = default;
+};
+
+struct IntervalKeyHash
+{
+	[[nodiscard]]
+	std::size_t operator()(IntervalKey key) const noexcept
+	{
+		auto const hash = key.value.numerator * 0x9e3779b97f4a7c15
+			^ (key.value.denominator + 0x632be59bd9b4e019);
+		return static_cast<std::size_t>(hash ^ (hash >> 29));
+	}
+};
+
+// Get the key of the interval from `low` up to `high`.
+[[nodiscard]] static
+IntervalKey get_interval_key(ChordPitch low, ChordPitch high) noexcept
+{
+	auto const inexact = IntervalKey{
+		{std::bit_cast<std::uint64_t>(high.ratio / low.ratio), 0}
+	};
+	if (!low.fraction.has_value() || !high.fraction.has_value())
+	{
+		return inexact;
+	}
+
+	// Cancelling common factors first leaves the product in lowest terms.
+	auto const [a, b] = *high.fraction;
+	auto const [c, d] = *low.fraction;
+	auto const g1 = std::gcd(a, c);
+	auto const g2 = std::gcd(b, d);
+	auto const left = a / g1;
+	auto const right = d / g2;
+	auto const bottom_left = b / g2;
+	auto const bottom_right = c / g1;
+
+	constexpr auto max = std::numeric_limits<std::uint64_t>::max();
+	if (left > max / right || bottom_left > max / bottom_right)
+	{
+		return inexact;
+	}
+	return {{left * right, bottom_left * bottom_right}};
+}
+
+[[nodiscard]]
+auto index_chord_intervals(std::span<Chord const> chords) -> ChordIntervals
+{
+	ChordIntervals result;
+	result.first_pairs.reserve(chords.size());
+
+	std::unordered_map<IntervalKey, std::uint32_t, IntervalKeyHash> indices;
+	for (auto const& chord : chords)
+	{
+		result.first_pairs.push_back(result.pair_intervals.size());
+
+		auto const& pitches = chord.pitches;
+		for (std::size_t i = 0; i < pitches.size(); ++i)
+		{
+			for (std::size_t j = i + 1; j < pitches.size(); ++j)
+			{
+				auto low = pitches[i];
+				auto high = pitches[j];
+				if (high.ratio < low.ratio)
+				{
+					std::swap(low, high);
+				}
+
+				auto const [position, inserted] = indices.try_emplace(
+					get_interval_key(low, high),
+					static_cast<std::uint32_t>(result.intervals.size())
+				);
+				if (inserted)
+				{
+					result.intervals.push_back(high.ratio / low.ratio);
+				}
+				result.pair_intervals.push_back(position->second);
+			}
+		}
+	}
+
+	return result;
+}
+} // namespace disscalc
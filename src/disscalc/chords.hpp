@@ -0,0 +1,146 @@
+#ifndef DISSCALC_CHORDS_HPP_INCLUDED
+#define DISSCALC_CHORDS_HPP_INCLUDED
+
+#include "disscalc/parallel.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace disscalc
+{
+/// Ratio of two positive whole numbers, in lowest terms.
+struct Fraction
+{
+	std::uint64_t numerator;
+	std::uint64_t denominator;
+
+	[[nodiscard]]
+	friend bool operator==(Fraction, Fraction) noexcept = default;
+};
+
+/// A note of a chord, given as a ratio to a common reference pitch.
+struct ChordPitch
+{
+	double ratio;
+
+	/// The ratio exactly, if it was given as a fraction rather than cents.
+	std::optional<Fraction> fraction;
+};
+
+/// A chord whose dissonance is the sum of that of each pair of its notes.
+struct Chord
+{
+	/// Text the chord was read from, used to identify it in output.
+	std::string name;
+
+	std::vector<ChordPitch> pitches;
+};
+
+/** Parse a single pitch of a chord.
+ *
+ * As in the Scala format, pitches containing a period are cents, and the
+ * others are ratios of whole numbers such as "5/4" or "2".
+ */
+[[nodiscard]]
+auto parse_chord_pitch(std::string_view token) noexcept
+	-> std::optional<ChordPitch>;
+
+/// Chords read from a file, along with where reading failed, if it did.
+struct ChordList
+{
+	std::vector<Chord> chords;
+
+	/// Number of the first malformed line, if any.
+	std::optional<std::size_t> error_line;
+};
+
+/** Read chords, one per line, as pitches separated by whitespace.
+ *
+ * Every note is given relative to the same reference, so "1/1 5/4 3/2" is a
+ * major triad. Blank lines and lines starting with '#' are skipped, and every
+ * other line must hold at least two pitches.
+ */
+[[nodiscard]]
+auto read_chords(std::istream& in) -> ChordList;
+
+/** Distinct intervals between pairs of notes of a batch of chords.
+ *
+ * The interval of a pair is the ratio of the higher pitch to the lower one.
+ * Pairs of fractions are identified by their exact ratio, and any other pairs
+ * by the exact value of the ratio.
+ */
+struct ChordIntervals
+{
+	/// Each distinct interval.
+	std::vector<double> intervals;
+
+	/// Index within `intervals` of each pair of notes of every chord in order.
+	std::vector<std::uint32_t> pair_intervals;
+
+	/// Index within `pair_intervals` of the first pair of each chord.
+	std::vector<std::size_t> first_pairs;
+};
+
+/// Find the distinct intervals between pairs of notes of `chords`.
+[[nodiscard]]
+auto index_chord_intervals(std::span<Chord const> chords) -> ChordIntervals;
+
+/** Compute the dissonance of each chord.
+ *
+ * The dissonance at each distinct interval is computed once, and those results
+ * are shared between every chord, so a batch drawn from a small vocabulary of
+ * pitches needs few calls to `dissonance_at`. Both steps run in parallel.
+ *
+ * @param thread_count the maximum number of threads, as for `parallel_for`.
+ */
+[[nodiscard]]
+auto evaluate_chords(
+	std::span<Chord const> chords,
+	std::size_t thread_count,
+	std::invocable<double> auto dissonance_at
+) -> std::vector<double>
+{
+	auto const indexed = index_chord_intervals(chords);
+
+	std::vector<double> dissonances(indexed.intervals.size());
+	parallel_for(
+		dissonances.size(),
+		thread_count,
+		[&](std::size_t i) noexcept(
+			std::is_nothrow_invocable_v<decltype(dissonance_at)&, double>
+		)
+		{
+			dissonances[i] = std::invoke(dissonance_at, indexed.intervals[i]);
+		}
+	);
+
+	std::vector<double> totals(chords.size());
+	parallel_for(chords.size(), thread_count, [&](std::size_t chord) noexcept
+	{
+		auto const first = indexed.first_pairs[chord];
+		auto const last = chord + 1 < chords.size()
+			? indexed.first_pairs[chord + 1]
+			: indexed.pair_intervals.size();
+
+		double total = 0.0;
+		for (auto pair = first; pair < last; ++pair)
+		{
+			total += dissonances[indexed.pair_intervals[pair]];
+		}
+		totals[chord] = total;
+	});
+
+	return totals;
+}
+} // namespace disscalc
+
+#endif
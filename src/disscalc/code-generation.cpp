@@ -0,0 +1,131 @@
+#include "disscalc/code-generation.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <ios>
+
+namespace disscalc
+{
+[[nodiscard]] static constexpr
+bool is_identifier_start(char c) noexcept
+{
+	return c == '_'
+		|| (c >= 'a' && c <= 'z')
+		|| (c >= 'A' && c <= 'Z');
+}
+
+[[nodiscard]] static constexpr
+bool is_identifier_char(char c) noexcept
+{
+	return is_identifier_start(c) || (c >= '0' && c <= '9');
+}
+
+[[nodiscard]]
+bool is_valid_cpp_namespace(std::string_view name) noexcept
+{
+	while (true)
+	{
+		auto const end = name.find("::");
+		auto const identifier = name.substr(0, end);
+		if (identifier.empty() || !is_identifier_start(identifier.front()))
+		{
+			return false;
+		}
+		for (auto const c : identifier)
+		{
+			if (!is_identifier_char(c))
+			{
+				return false;
+			}
+		}
+
+		if (end == std::string_view::npos)
+		{
+			return true;
+		}
+		name.remove_prefix(end + 2);
+	}
+}
+
+// Number of array elements written on each line of an initializer.
+constexpr std::size_t elements_per_line = 3;
+
+// Write an array initialized with `member` of each row.
+static
+void write_array(
+	std::ostream& out,
+	std::string_view name,
+	std::span<TableRow const> rows,
+	double TableRow::* member
+)
+{
+	out << "\ninline constexpr double " << name << "[size] = {";
+	for (std::size_t i = 0; i < rows.size(); ++i)
+	{
+		out << (i % elements_per_line == 0 ? "\n\t" : " ")
+			<< rows[i].*member << ',';
+	}
+	out << "\n};\n";
+}
+
+// Write the definition of `interpolate`.
+static
+void write_interpolation(std::ostream& out)
+{
+	out <<
+		"\n/// Linearly interpolate the dissonance at `interval`.\n"
+		"constexpr double interpolate(double interval) noexcept\n"
+		"{\n"
+		"\tif (!(interval > intervals[0]))\n"
+		"\t{\n"
+		"\t\treturn dissonances[0];\n"
+		"\t}\n"
+		"\tif (!(interval < intervals[size - 1]))\n"
+		"\t{\n"
+		"\t\treturn dissonances[size - 1];\n"
+		"\t}\n"
+		"\n"
+		"\t// Find the rows on either side of the interval.\n"
+		"\tstd::size_t low = 0;\n"
+		"\tstd::size_t high = size - 1;\n"
+		"\twhile (high - low > 1)\n"
+		"\t{\n"
+		"\t\tauto const middle = low + (high - low) / 2;\n"
+		"\t\t(intervals[middle] < interval ? low : high) = middle;\n"
+		"\t}\n"
+		"\n"
+		"\tauto const t = (interval - intervals[low])\n"
+		"\t\t/ (intervals[high] - intervals[low]);\n"
+		"\treturn dissonances[low]\n"
+		"\t\t+ t * (dissonances[high] - dissonances[low]);\n"
+		"}\n";
+}
+
+void write_table_as_cpp(
+	std::ostream& out,
+	std::span<TableRow const> rows,
+	CppHeaderSettings const& settings
+)
+{
+	assert(!rows.empty());
+	auto const old_flags = out.flags();
+
+	out << "// Generated by disscalc.\n"
+		<< "#pragma once\n\n"
+		<< "#include <cstddef>\n\n"
+		<< "namespace " << settings.namespace_name << "\n{\n"
+		<< "inline constexpr std::size_t size = " << rows.size() << ";\n"
+		<< std::hexfloat;
+
+	write_array(out, "intervals", rows, &TableRow::input);
+	write_array(out, "dissonances", rows, &TableRow::output);
+
+	if (settings.interpolation)
+	{
+		write_interpolation(out);
+	}
+
+	out << "} // namespace " << settings.namespace_name << '\n';
+	out.flags(old_flags);
+}
+} // namespace disscalc
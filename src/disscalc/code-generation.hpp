@@ -0,0 +1,45 @@
+#ifndef DISSCALC_CODE_GENERATION_HPP_INCLUDED
+#define DISSCALC_CODE_GENERATION_HPP_INCLUDED
+
+#include "disscalc/table.hpp"
+
+#include <iostream>
+#include <span>
+#include <string_view>
+
+namespace disscalc
+{
+/// Settings for a generated C++ header.
+struct CppHeaderSettings
+{
+	/// Namespace holding every declaration, which may be nested with "::".
+	std::string_view namespace_name = "dissonance_curve";
+
+	/// Whether to define a function interpolating between rows.
+	bool interpolation = false;
+};
+
+/** Indicate whether `name` can be used as the namespace of a generated header.
+ *
+ * It must be one or more identifiers separated by "::".
+ */
+[[nodiscard]]
+bool is_valid_cpp_namespace(std::string_view name) noexcept;
+
+/** Write a self-contained C++ header holding the rows of a table.
+ *
+ * The header defines `constexpr` arrays `intervals` and `dissonances` of
+ * length `size`, with every number written exactly as a hexadecimal floating
+ * point literal. Initializers are split into short lines so that even very
+ * large tables compile quickly. If requested, it also defines `constexpr`
+ * function `interpolate`, which linearly interpolates between rows and clamps
+ * to the first and last rows. There must be at least one row.
+ */
+void write_table_as_cpp(
+	std::ostream& out,
+	std::span<TableRow const> rows,
+	CppHeaderSettings const& settings
+);
+} // namespace disscalc
+
+#endif
@@ -0,0 +1,164 @@
+#ifndef DISSCALC_DECIMATION_HPP_INCLUDED
+#define DISSCALC_DECIMATION_HPP_INCLUDED
+
+#include "disscalc/table.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace disscalc
+{
+/** Streaming decimation of table rows that preserves the shape of the curve.
+ *
+ * Rows are added in order of increasing input. A row is dropped when the line
+ * between the rows kept on either side of it reproduces its output to within
+ * `tolerance`. The first and last rows, local extrema and extra values are
+ * always kept.
+ *
+ * Every row kept is the end of a segment starting at the previous kept row.
+ * Each dropped row restricts the slope of that segment to an interval, so
+ * whether a new row can end the segment is checked in constant time, and only
+ * the latest row is buffered.
+ */
+template <std::invocable<TableRow const&> Output>
+class Decimator
+{
+public:
+	Decimator(double tolerance, Output output)
+		noexcept(std::is_nothrow_move_constructible_v<Output>)
+		: tolerance_(tolerance),
+		output_(std::move(output))
+	{}
+
+	/// Add the next row, passing on any rows that must be kept.
+	void add(TableRow const& row)
+	{
+		if (!anchor_.has_value())
+		{
+			keep(row);
+			return;
+		}
+		assert(row.input > anchor_->input);
+
+		if (!end_.has_value())
+		{
+			start_segment(row);
+			return;
+		}
+
+		if (is_extremum(*end_, row) || !fits(row))
+		{
+			// The current end cannot be dropped, so it starts a new segment.
+			keep(*end_);
+			end_.reset();
+
+			if (row.is_extra)
+			{
+				keep(row);
+			}
+			else
+			{
+				start_segment(row);
+			}
+			return;
+		}
+
+		if (row.is_extra)
+		{
+			// The current end comes first, so it is passed on before the row.
+			keep(*end_);
+			end_.reset();
+			keep(row);
+			return;
+		}
+
+		restrict_slopes(row);
+		previous_ = end_;
+		end_ = row;
+	}
+
+	/// Pass on the last row, if it has not been already.
+	void finish(void)
+	{
+		if (end_.has_value())
+		{
+			keep(*end_);
+			end_.reset();
+		}
+	}
+
+private:
+	// Pass on `row` and start a new segment from it.
+	void keep(TableRow const& row)
+	{
+		std::invoke(output_, row);
+		previous_ = anchor_;
+		anchor_ = row;
+		least_slope_ = -std::numeric_limits<double>::infinity();
+		greatest_slope_ = std::numeric_limits<double>::infinity();
+	}
+
+	// Make `row` the tentative end of the segment from the anchor.
+	void start_segment(TableRow const& row)
+	{
+		if (row.is_extra)
+		{
+			keep(row);
+			return;
+		}
+		restrict_slopes(row);
+		previous_ = anchor_;
+		end_ = row;
+	}
+
+	// Restrict the slope of the segment so that `row` can be dropped.
+	void restrict_slopes(TableRow const& row) noexcept
+	{
+		double const run = row.input - anchor_->input;
+		double const rise = row.output - anchor_->output;
+		least_slope_ = std::max(least_slope_, (rise - tolerance_) / run);
+		greatest_slope_ = std::min(greatest_slope_, (rise + tolerance_) / run);
+	}
+
+	// Indicate whether the segment may end at `row`.
+	[[nodiscard]]
+	bool fits(TableRow const& row) const noexcept
+	{
+		double const slope = (row.output - anchor_->output)
+			/ (row.input - anchor_->input);
+		return slope >= least_slope_ && slope <= greatest_slope_;
+	}
+
+	// Indicate whether `middle` is a local extremum before `next`.
+	[[nodiscard]]
+	bool is_extremum(TableRow const& middle, TableRow const& next) const noexcept
+	{
+		double const before = middle.output - previous_->output;
+		double const after = next.output - middle.output;
+		return (before > 0.0 && after < 0.0) || (before < 0.0 && after > 0.0);
+	}
+
+	double tolerance_;
+	Output output_;
+
+	// The last row kept, which starts the current segment.
+	std::optional<TableRow> anchor_;
+
+	// The latest row, which ends the current segment if no others are added.
+	std::optional<TableRow> end_;
+
+	// The row added before `end_`.
+	std::optional<TableRow> previous_;
+
+	double least_slope_ = -std::numeric_limits<double>::infinity();
+	double greatest_slope_ = std::numeric_limits<double>::infinity();
+};
+} // namespace disscalc
+
+#endif
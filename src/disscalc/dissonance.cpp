@@ -1,37 +1,12 @@
 #include "disscalc/dissonance.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 
 namespace disscalc
 {
-// Compute the dissonance between two partials.
-[[nodiscard]] static constexpr
-double compute_dissonance_between_partials(Partial a, Partial b) noexcept
-{
-	// Magic numbers not explained in the original program.
-	constexpr double dstar = 0.24;
-	constexpr double s1 = 0.0207;
-	constexpr double s2 = 18.96;
-	constexpr double c1 = 5.0;
-	constexpr double c2 = -5.0;
-	constexpr double a1 = -3.51;
-	constexpr double a2 = -5.75;
-
-	double const least_amp = std::min(a.amplitude, b.amplitude);
-	double const least_freq = std::min(a.frequency, b.frequency);
-	double const freq_diff = std::abs(b.frequency - a.frequency);
-
-	double const s = dstar / (s1 * least_freq + s2);
-	double const arg1 = a1 * s * freq_diff;
-	double const arg2 = a2 * s * freq_diff;
-
-	double const exp1 = arg1 < -88 ? 0 : std::exp(arg1);
-	double const exp2 = arg2 < -88 ? 0 : std::exp(arg2);
-
-	return least_amp * (c1 * exp1 + c2 * exp2);
-}
-
+template <DissonanceModelPolicy Model>
 [[nodiscard]]
 double compute_dissonance(
 	std::span<Partial const> stable_partials,
@@ -46,7 +21,7 @@ double compute_dissonance(
 		{
 			// Partial when raised by the interval.
 			mobile_partial.frequency *= interval;
-			dissonance += compute_dissonance_between_partials(
+			dissonance += compute_dissonance_between_partials<Model>(
 				stable_partial,
 				mobile_partial
 			);
@@ -55,4 +30,82 @@ double compute_dissonance(
 
 	return dissonance;
 }
+
+template <DissonanceModelPolicy Model>
+void compute_dissonances(
+	std::span<Partial const> stable_partials,
+	std::span<std::vector<Partial> const> mobile_timbres,
+	double interval,
+	std::span<double> dissonances
+) noexcept
+{
+	assert(mobile_timbres.size() == dissonances.size());
+
+	std::ranges::fill(dissonances, 0.0);
+	for (auto const stable_partial : stable_partials)
+	{
+		for (std::size_t i = 0; i < mobile_timbres.size(); ++i)
+		{
+			// Summed in the same order as by `compute_dissonance`.
+			auto& dissonance = dissonances[i];
+			for (auto mobile_partial : mobile_timbres[i])
+			{
+				mobile_partial.frequency *= interval;
+				dissonance += compute_dissonance_between_partials<Model>(
+					stable_partial,
+					mobile_partial
+				);
+			}
+		}
+	}
+}
+
+template double compute_dissonance<SetharesModel>(
+	std::span<Partial const>,
+	std::span<Partial const>,
+	double
+) noexcept;
+template double compute_dissonance<ProductModel>(
+	std::span<Partial const>,
+	std::span<Partial const>,
+	double
+) noexcept;
+template double compute_dissonance<VassilakisModel>(
+	std::span<Partial const>,
+	std::span<Partial const>,
+	double
+) noexcept;
+
+template void compute_dissonances<SetharesModel>(
+	std::span<Partial const>,
+	std::span<std::vector<Partial> const>,
+	double,
+	std::span<double>
+) noexcept;
+template void compute_dissonances<ProductModel>(
+	std::span<Partial const>,
+	std::span<std::vector<Partial> const>,
+	double,
+	std::span<double>
+) noexcept;
+template void compute_dissonances<VassilakisModel>(
+	std::span<Partial const>,
+	std::span<std::vector<Partial> const>,
+	double,
+	std::span<double>
+) noexcept;
+
+[[nodiscard]]
+double compute_dissonance(
+	std::span<Partial const> stable_partials,
+	std::span<Partial const> mobile_partials,
+	double interval
+) noexcept
+{
+	return compute_dissonance<SetharesModel>(
+		stable_partials,
+		mobile_partials,
+		interval
+	);
+}
 } // namespace disscalc
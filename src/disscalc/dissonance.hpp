@@ -1,19 +1,44 @@
 #ifndef DISSCALC_DISSONANCE_HPP_INCLUDED
 #define DISSCALC_DISSONANCE_HPP_INCLUDED
 
+#include "disscalc/models.hpp"
+#include "disscalc/partial.hpp"
+
 #include <span>
 #include <vector>
 
 namespace disscalc
 {
-/// Data associated with a partial; that is, its frequency and amplitude.
-struct Partial
-{
-	double frequency;
-	double amplitude;
-};
+/** Compute dissonance of a frequency based on a list of partials.
+ *
+ * Instantiations exist for every model in `DissonanceModel`.
+ */
+template <DissonanceModelPolicy Model>
+[[nodiscard]]
+double compute_dissonance(
+	std::span<Partial const> stable_partials,
+	std::span<Partial const> mobile_partials,
+	double interval
+) noexcept;
+
+/** Compute the dissonance of a frequency for each of several mobile timbres.
+ *
+ * This gives exactly the same results as calling `compute_dissonance` for each
+ * mobile timbre, but each stable partial is only loaded once for all of them.
+ * Instantiations exist for every model in `DissonanceModel`.
+ *
+ * @param dissonances receives the dissonance for each mobile timbre, and must
+ * have the same size as `mobile_timbres`.
+ */
+template <DissonanceModelPolicy Model>
+void compute_dissonances(
+	std::span<Partial const> stable_partials,
+	std::span<std::vector<Partial> const> mobile_timbres,
+	double interval,
+	std::span<double> dissonances
+) noexcept;
 
-/// Compute dissonance of a frequency based on a list of partials.
+/// Compute dissonance using the default model, `SetharesModel`.
 [[nodiscard]]
 double compute_dissonance(
 	std::span<Partial const> stable_partials,
@@ -0,0 +1,106 @@
+#ifndef DISSCALC_ENGINE_HPP_INCLUDED
+#define DISSCALC_ENGINE_HPP_INCLUDED
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string_view>
+
+namespace disscalc
+{
+/// Method used to compute the rows of a dissonance curve.
+enum struct Engine
+{
+	/// Sum the dissonance of every pair of partials at each interval.
+	exact,
+
+	/// Approximate the whole curve at once with fast Fourier transforms.
+	fft,
+
+	/// Compute the same sums as `exact` over tiles of intervals and partials.
+	blocked,
+};
+
+/// Find the engine with the given name.
+[[nodiscard]] constexpr
+auto find_engine(std::string_view name) noexcept -> std::optional<Engine>
+{
+	if (name == "exact")
+	{
+		return Engine::exact;
+	}
+	if (name == "fft")
+	{
+		return Engine::fft;
+	}
+	if (name == "blocked")
+	{
+		return Engine::blocked;
+	}
+	return std::nullopt;
+}
+
+/// Error of an approximate curve measured at a sample of its intervals.
+struct EngineError
+{
+	/// Number of intervals at which the error was measured.
+	std::size_t sample_count;
+
+	/// Greatest absolute difference from the exact dissonance.
+	double max_absolute;
+
+	/// `max_absolute` relative to the greatest exact dissonance.
+	double max_relative;
+
+	/**
+	 * Number of stable partials the error was estimated from, if the timbres
+	 * were too large to measure it with all of them, and otherwise zero.
+	 */
+	std::size_t sampled_partials = 0;
+};
+
+/** Measure the error of an approximate curve at evenly spaced rows.
+ *
+ * @param intervals the interval of each row.
+ *
+ * @param approximate the approximate dissonance of each row.
+ *
+ * @param sample_count the number of rows at which to measure the error, which
+ * is reduced to the number of rows if there are fewer.
+ *
+ * @param exact function giving the exact dissonance of an interval.
+ */
+[[nodiscard]]
+auto measure_engine_error(
+	std::span<double const> intervals,
+	std::span<double const> approximate,
+	std::size_t sample_count,
+	std::invocable<double> auto exact
+) -> EngineError
+{
+	sample_count = std::min(sample_count, intervals.size());
+
+	EngineError error{sample_count, 0.0, 0.0};
+	double greatest = 0.0;
+	for (std::size_t i = 0; i < sample_count; ++i)
+	{
+		auto const row = sample_count == 1
+			? intervals.size() / 2
+			: i * (intervals.size() - 1) / (sample_count - 1);
+		double const value = std::invoke(exact, intervals[row]);
+		error.max_absolute = std::max(
+			error.max_absolute,
+			std::abs(approximate[row] - value)
+		);
+		greatest = std::max(greatest, std::abs(value));
+	}
+	error.max_relative = greatest > 0.0 ? error.max_absolute / greatest : 0.0;
+	return error;
+}
+} // namespace disscalc
+
+#endif
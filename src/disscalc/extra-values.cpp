@@ -0,0 +1,187 @@
+#include "disscalc/extra-values.hpp"
+
+#include "disscalc/binary-io.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace disscalc
+{
+void sort_extra_values(std::vector<double>& values)
+{
+	std::ranges::stable_sort(values);
+	auto const duplicates = std::ranges::unique(values);
+	values.erase(std::begin(duplicates), std::end(duplicates));
+}
+
+[[nodiscard]]
+auto merge_extra_values(std::vector<double> a, std::vector<double> b)
+	-> std::vector<double>
+{
+	if (a.empty())
+	{
+		return b;
+	}
+	if (b.empty())
+	{
+		return a;
+	}
+
+	std::vector<double> merged;
+	merged.reserve(a.size() + b.size());
+	std::ranges::set_union(a, b, std::back_inserter(merged));
+	return merged;
+}
+
+constexpr std::string_view extra_values_magic = "DISSXTRA";
+
+/*
+ * Collects values into a sorted list without duplicates. As long as values
+ * arrive in increasing order, each is merged as it is added, and the values
+ * are only sorted at the end once one arrives out of order.
+ */
+class ExtraValueCollector
+{
+public:
+	void add(double value)
+	{
+		if (!values_.empty() && !(values_.back() < value))
+		{
+			if (values_.back() == value)
+			{
+				return;
+			}
+			sorted_ = false;
+		}
+		values_.push_back(value);
+	}
+
+	[[nodiscard]]
+	auto finish(void) && -> std::vector<double>
+	{
+		if (!sorted_)
+		{
+			sort_extra_values(values_);
+		}
+		values_.shrink_to_fit();
+		return std::move(values_);
+	}
+
+private:
+	std::vector<double> values_;
+	bool sorted_ = true;
+};
+
+[[nodiscard]] static
+bool is_valid_extra_value(double value) noexcept
+{
+	return value > 0.0 && std::isfinite(value);
+}
+
+[[nodiscard]] static
+auto read_binary_extra_values(std::istream& in) -> ExtraValueList
+{
+	std::array<char, extra_values_magic.size()> magic;
+	if (
+		!in.read(magic.data(), magic.size())
+		|| std::string_view(magic.data(), magic.size()) != extra_values_magic
+	)
+	{
+		return {{}, 1};
+	}
+
+	ExtraValueCollector values;
+	constexpr auto eof = std::istream::traits_type::eof();
+	for (std::size_t position = 1; in.peek() != eof; ++position)
+	{
+		auto const value = read_little_endian_double(in);
+		if (!value.has_value() || !is_valid_extra_value(*value))
+		{
+			return {{}, position};
+		}
+		values.add(*value);
+	}
+	return {std::move(values).finish(), std::nullopt};
+}
+
+// Parse each value on a line of a text list, returning false on failure.
+[[nodiscard]] static
+bool parse_extra_value_line(
+	std::string_view line,
+	ExtraValueCollector& values
+)
+{
+	constexpr std::string_view whitespace = " \t\r";
+
+	for (
+		auto start = line.find_first_not_of(whitespace);
+		start != std::string_view::npos;
+		start = line.find_first_not_of(whitespace, start)
+	)
+	{
+		auto const end = std::min(
+			line.find_first_of(whitespace, start),
+			line.size()
+		);
+
+		double value;
+		auto const [parsed_end, error] = std::from_chars(
+			line.data() + start,
+			line.data() + end,
+			value
+		);
+		if (
+			error != std::errc()
+			|| parsed_end != line.data() + end
+			|| !is_valid_extra_value(value)
+		)
+		{
+			return false;
+		}
+
+		values.add(value);
+		start = end;
+	}
+	return true;
+}
+
+[[nodiscard]]
+auto read_extra_values(std::istream& in) -> ExtraValueList
+{
+	// No number starts with the first letter of the magic bytes.
+	if (in.peek() == extra_values_magic.front())
+	{
+		return read_binary_extra_values(in);
+	}
+
+	ExtraValueCollector values;
+	std::string line;
+	for (std::size_t line_number = 1; std::getline(in, line); ++line_number)
+	{
+		auto const first = line.find_first_not_of(" \t\r");
+		if (first == std::string::npos || line[first] == '#')
+		{
+			continue;
+		}
+		if (!parse_extra_value_line(line, values))
+		{
+			return {{}, line_number};
+		}
+	}
+	return {std::move(values).finish(), std::nullopt};
+}
+
+void write_extra_values(std::ostream& out, std::vector<double> const& values)
+{
+	out.write(extra_values_magic.data(), extra_values_magic.size());
+	for (auto const value : values)
+	{
+		write_little_endian_double(out, value);
+	}
+}
+} // namespace disscalc
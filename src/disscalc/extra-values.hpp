@@ -0,0 +1,53 @@
+#ifndef DISSCALC_EXTRA_VALUES_HPP_INCLUDED
+#define DISSCALC_EXTRA_VALUES_HPP_INCLUDED
+
+#include <cstddef>
+#include <iostream>
+#include <optional>
+#include <vector>
+
+namespace disscalc
+{
+/// Sort `values` and remove duplicates, as expected by table inputs.
+void sort_extra_values(std::vector<double>& values);
+
+/** Merge two lists of extra values, each sorted without duplicates.
+ *
+ * The result is sorted and has no duplicates.
+ */
+[[nodiscard]]
+auto merge_extra_values(std::vector<double> a, std::vector<double> b)
+	-> std::vector<double>;
+
+/// Extra values read from a file, along with where reading failed, if it did.
+struct ExtraValueList
+{
+	/// The values in increasing order, without duplicates.
+	std::vector<double> values;
+
+	/**
+	 * Number of the first malformed line of a text file, or of the first
+	 * malformed value of a binary one, if any.
+	 */
+	std::optional<std::size_t> error_position;
+};
+
+/** Read a list of extra values.
+ *
+ * A text list holds values separated by whitespace on any number of lines,
+ * where blank lines and lines starting with '#' are skipped. A binary list
+ * starts with the eight bytes "DISSXTRA", followed by each value as a 64-bit
+ * little-endian IEEE 754 floating point number. Every value must be positive
+ * and finite.
+ *
+ * Values given in increasing order are merged as they are read, without
+ * sorting them afterward.
+ */
+[[nodiscard]]
+auto read_extra_values(std::istream& in) -> ExtraValueList;
+
+/// Write `values` in the binary format read by `read_extra_values`.
+void write_extra_values(std::ostream& out, std::vector<double> const& values);
+} // namespace disscalc
+
+#endif
@@ -0,0 +1,400 @@
+#include "disscalc/fft-engine.hpp"
+
+#include "disscalc/fft.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <concepts>
+#include <cstdint>
+#include <map>
+
+namespace disscalc
+{
+// Range of integer points of a grid covering some real positions.
+struct GridRange
+{
+	std::int64_t first;
+	std::size_t size;
+};
+
+// Get the grid points needed to linearly interpolate at every position.
+[[nodiscard]] static
+auto find_grid_range(std::span<double const> positions) noexcept -> GridRange
+{
+	assert(!positions.empty());
+	auto const [least, greatest] = std::ranges::minmax(positions);
+	auto const first = static_cast<std::int64_t>(std::floor(least));
+	auto const last = static_cast<std::int64_t>(std::floor(greatest)) + 1;
+	return {first, static_cast<std::size_t>(last - first + 1)};
+}
+
+// Add `value` to the two points of `grid` on either side of `position`.
+static
+void add_to_grid(
+	std::span<std::complex<double>> grid,
+	double position,
+	std::complex<double> value
+) noexcept
+{
+	auto const floor = std::floor(position);
+	auto const i = static_cast<std::size_t>(floor);
+	auto const t = position - floor;
+	grid[i] += (1.0 - t) * value;
+	grid[i + 1] += t * value;
+}
+
+/*
+ * Get the amplitudes at which the weighting is sampled, starting at zero.
+ *
+ * The weighting of a pair is interpolated linearly in the stable amplitude
+ * between the thresholds on either side of it. The lesser of two amplitudes
+ * is linear in each amplitude on either side of the other, so with a
+ * threshold at every distinct amplitude this is exact. Otherwise, the
+ * thresholds are spaced geometrically.
+ */
+[[nodiscard]] static
+auto find_amplitude_thresholds(
+	std::span<Partial const> stable_partials,
+	std::span<Partial const> mobile_partials,
+	std::size_t threshold_count
+) -> std::vector<double>
+{
+	std::vector<double> amplitudes;
+	for (auto const partials : {stable_partials, mobile_partials})
+	{
+		for (auto const& partial : partials)
+		{
+			amplitudes.push_back(partial.amplitude);
+		}
+	}
+	std::ranges::stable_sort(amplitudes);
+	auto const duplicates = std::ranges::unique(amplitudes);
+	amplitudes.erase(duplicates.begin(), duplicates.end());
+
+	std::vector<double> thresholds = {0.0};
+	if (amplitudes.size() <= threshold_count)
+	{
+		thresholds.insert(
+			thresholds.end(),
+			amplitudes.begin(),
+			amplitudes.end()
+		);
+		return thresholds;
+	}
+
+	auto const ratio = amplitudes.back() / amplitudes.front();
+	for (std::size_t t = 0; t < threshold_count; ++t)
+	{
+		auto const exponent = threshold_count == 1
+			? 1.0
+			: static_cast<double>(t) / static_cast<double>(threshold_count - 1);
+		thresholds.push_back(amplitudes.front() * std::pow(ratio, exponent));
+	}
+	thresholds.back() = amplitudes.back();
+	return thresholds;
+}
+
+// Weight of a stable partial at one amplitude threshold.
+struct ThresholdWeight
+{
+	std::size_t threshold;
+	std::size_t partial;
+	double weight;
+};
+
+/*
+ * Split element `k` of the transform of `a + i b`, for real sequences `a` and
+ * `b`, into element `k` of the transforms of `a` and `b`.
+ */
+[[nodiscard]] static
+auto split_real_transforms(
+	std::span<std::complex<double> const> transform,
+	std::size_t k
+) noexcept -> std::array<std::complex<double>, 2>
+{
+	auto const z = transform[k];
+	auto const mirror = std::conj(
+		transform[(transform.size() - k) % transform.size()]
+	);
+	return {0.5 * (z + mirror), std::complex<double>(0.0, -0.5) * (z - mirror)};
+}
+
+template <DissonanceModelPolicy Model>
+[[nodiscard]]
+auto compute_dissonance_curve_fft(
+	std::span<Partial const> stable_partials,
+	std::span<Partial const> mobile_partials,
+	std::span<double const> intervals,
+	FftEngineSettings const& settings
+) -> std::vector<double>
+{
+	static_assert(has_fft_engine<Model>);
+	assert(settings.resolution > 0.0);
+	assert(settings.band_tolerance > 0.0);
+	assert(settings.amplitude_thresholds > 0);
+
+	std::vector<double> dissonances(intervals.size(), 0.0);
+	if (
+		intervals.empty()
+		|| stable_partials.empty()
+		|| mobile_partials.empty()
+	)
+	{
+		return dissonances;
+	}
+
+	// Positions on the logarithmic grid.
+	auto const to_grid = [&](double x)
+	{
+		return std::log(x) / settings.resolution;
+	};
+	std::vector<double> stable_positions;
+	for (auto const& partial : stable_partials)
+	{
+		stable_positions.push_back(to_grid(partial.frequency));
+	}
+	std::vector<double> mobile_positions;
+	for (auto const& partial : mobile_partials)
+	{
+		mobile_positions.push_back(to_grid(partial.frequency));
+	}
+	std::vector<double> interval_positions;
+	for (auto const interval : intervals)
+	{
+		interval_positions.push_back(to_grid(interval));
+	}
+
+	auto const stable_range = find_grid_range(stable_positions);
+	auto const mobile_range = find_grid_range(mobile_positions);
+	auto const interval_range = find_grid_range(interval_positions);
+
+	/*
+	 * With the stable grid reversed, the sum of the products of every pair of
+	 * stable and mobile points is a convolution indexed by the difference of
+	 * their positions, which is then correlated with the roughness kernel
+	 * over every interval. The FFT must be large enough that neither wraps.
+	 */
+	auto const kernel_size = stable_range.size
+		+ mobile_range.size
+		+ interval_range.size
+		- 2;
+	std::size_t fft_size = 1;
+	while (fft_size < kernel_size)
+	{
+		fft_size *= 2;
+	}
+
+	// Grid difference between positions at the first index of the kernel.
+	auto const kernel_offset = mobile_range.first
+		+ interval_range.first
+		- stable_range.first
+		- static_cast<std::int64_t>(stable_range.size - 1);
+
+	/*
+	 * The product weighting is linear in the stable amplitude, so it only
+	 * needs the thresholds 0 and 1.
+	 */
+	std::vector<double> thresholds = {0.0, 1.0};
+	if constexpr (!std::same_as<Model, ProductModel>)
+	{
+		thresholds = find_amplitude_thresholds(
+			stable_partials,
+			mobile_partials,
+			settings.amplitude_thresholds
+		);
+	}
+
+	using Spectrum = std::vector<std::complex<double>>;
+
+	// The weighting at the zero threshold is zero, so it is left out.
+	std::vector<Spectrum> mobile_spectra(thresholds.size());
+	for (std::size_t t = 1; t < thresholds.size(); ++t)
+	{
+		mobile_spectra[t].resize(fft_size);
+		for (std::size_t j = 0; j < mobile_partials.size(); ++j)
+		{
+			add_to_grid(
+				mobile_spectra[t],
+				mobile_positions[j] - static_cast<double>(mobile_range.first),
+				Model::weight(thresholds[t], mobile_partials[j].amplitude)
+			);
+		}
+		fft(mobile_spectra[t]);
+	}
+
+	// Add the weights of a stable partial at the thresholds around it.
+	std::vector<ThresholdWeight> weights;
+	auto const add_weights = [&](std::size_t i)
+	{
+		auto const amplitude = stable_partials[i].amplitude;
+		auto const upper = std::clamp<std::size_t>(
+			static_cast<std::size_t>(
+				std::ranges::upper_bound(thresholds, amplitude)
+					- thresholds.begin()
+			),
+			1,
+			thresholds.size() - 1
+		);
+		auto const x = (amplitude - thresholds[upper - 1])
+			/ (thresholds[upper] - thresholds[upper - 1]);
+		if (upper > 1 && x != 1.0)
+		{
+			weights.push_back({upper - 1, i, 1.0 - x});
+		}
+		if (x != 0.0)
+		{
+			weights.push_back({upper, i, x});
+		}
+	};
+
+	/*
+	 * Roughness scales with the difference of log frequencies divided by
+	 * `s1 + s2 / f`, where `f` is the lesser frequency. Stable partials are
+	 * grouped into bands over which the log of that divisor changes by at
+	 * most the tolerance. Each band uses the kernel of its center, corrected
+	 * to first order in the distance of each partial from the center.
+	 */
+	std::vector<double> log_divisors;
+	std::map<std::int64_t, std::vector<std::size_t>> bands;
+	for (std::size_t i = 0; i < stable_partials.size(); ++i)
+	{
+		log_divisors.push_back(
+			std::log(Model::s1 + Model::s2 / stable_partials[i].frequency)
+		);
+		bands[static_cast<std::int64_t>(
+			std::floor(log_divisors.back() / settings.band_tolerance)
+		)].push_back(i);
+	}
+
+	// Kernel of a band with the given log divisor.
+	auto const kernel_at = [&](double log_divisor, std::size_t e)
+	{
+		auto const frequency = Model::s2 / (std::exp(log_divisor) - Model::s1);
+		auto const difference = static_cast<double>(
+			static_cast<std::int64_t>(e) + kernel_offset
+		) * settings.resolution;
+		return compute_dissonance_between_partials<Model>(
+			{frequency, 1.0},
+			{frequency * std::exp(difference), 1.0}
+		);
+	};
+	auto const step = 1e-3 * settings.band_tolerance;
+
+	/*
+	 * The kernel and its correction, and likewise the stable grid and its
+	 * correction, are transformed together as the real and imaginary parts of
+	 * one sequence, then split apart.
+	 */
+	Spectrum total(fft_size);
+	Spectrum kernels(fft_size);
+	Spectrum stable(fft_size);
+	std::array<Spectrum, 2> band_sums = {
+		Spectrum(fft_size),
+		Spectrum(fft_size)
+	};
+	for (auto const& [band, members] : bands)
+	{
+		// The center is kept within the band's partials, since the divisor
+		// is only meaningful above `s1`.
+		auto const [least, greatest] = std::ranges::minmax(
+			members,
+			{},
+			[&](std::size_t i) noexcept { return log_divisors[i]; }
+		);
+		auto const center = std::clamp(
+			(static_cast<double>(band) + 0.5) * settings.band_tolerance,
+			log_divisors[least],
+			log_divisors[greatest]
+		);
+
+		std::ranges::fill(kernels, 0.0);
+		for (std::size_t e = 0; e < kernel_size; ++e)
+		{
+			auto const slope = (
+				kernel_at(center + step, e) - kernel_at(center - step, e)
+			) / (2.0 * step);
+			kernels[e] = {kernel_at(center, e), slope};
+		}
+		fft(kernels);
+
+		for (auto& band_sum : band_sums)
+		{
+			std::ranges::fill(band_sum, 0.0);
+		}
+
+		weights.clear();
+		for (auto const i : members)
+		{
+			add_weights(i);
+		}
+		std::ranges::stable_sort(weights, {}, &ThresholdWeight::threshold);
+
+		// Transform the stable partials weighted at each threshold together.
+		auto it = weights.begin();
+		while (it != weights.end())
+		{
+			auto const threshold = it->threshold;
+			std::ranges::fill(stable, 0.0);
+			for (; it != weights.end() && it->threshold == threshold; ++it)
+			{
+				auto const i = it->partial;
+				add_to_grid(
+					stable,
+					static_cast<double>(stable_range.first)
+						+ static_cast<double>(stable_range.size - 1)
+						- stable_positions[i],
+					{it->weight, it->weight * (log_divisors[i] - center)}
+				);
+			}
+
+			fft(stable);
+			for (std::size_t k = 0; k < fft_size; ++k)
+			{
+				auto const [plain, correction]
+					= split_real_transforms(stable, k);
+				auto const mobile = mobile_spectra[threshold][k];
+				band_sums[0][k] += plain * mobile;
+				band_sums[1][k] += correction * mobile;
+			}
+		}
+
+		for (std::size_t k = 0; k < fft_size; ++k)
+		{
+			auto const [kernel, slope] = split_real_transforms(kernels, k);
+			total[k] += kernel * std::conj(band_sums[0][k])
+				+ slope * std::conj(band_sums[1][k]);
+		}
+	}
+
+	fft(total, true);
+
+	for (std::size_t r = 0; r < intervals.size(); ++r)
+	{
+		auto const position = interval_positions[r]
+			- static_cast<double>(interval_range.first);
+		auto const floor = std::floor(position);
+		auto const k = static_cast<std::size_t>(floor);
+		auto const t = position - floor;
+		dissonances[r] = ((1.0 - t) * total[k].real() + t * total[k + 1].real())
+			/ static_cast<double>(fft_size);
+	}
+
+	return dissonances;
+}
+
+template auto compute_dissonance_curve_fft<SetharesModel>(
+	std::span<Partial const>,
+	std::span<Partial const>,
+	std::span<double const>,
+	FftEngineSettings const&
+) -> std::vector<double>;
+template auto compute_dissonance_curve_fft<ProductModel>(
+	std::span<Partial const>,
+	std::span<Partial const>,
+	std::span<double const>,
+	FftEngineSettings const&
+) -> std::vector<double>;
+} // namespace disscalc
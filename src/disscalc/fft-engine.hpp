@@ -0,0 +1,72 @@
+#ifndef DISSCALC_FFT_ENGINE_HPP_INCLUDED
+#define DISSCALC_FFT_ENGINE_HPP_INCLUDED
+
+#include "disscalc/models.hpp"
+#include "disscalc/partial.hpp"
+
+#include <cstddef>
+#include <numbers>
+#include <span>
+#include <vector>
+
+namespace disscalc
+{
+/// Indicate whether the FFT engine supports a model.
+template <DissonanceModelPolicy Model>
+constexpr bool has_fft_engine = false;
+
+/*
+ * The weighting of these models is linear in the stable amplitude between a
+ * few thresholds, at each of which it depends only on the mobile amplitude.
+ */
+template <>
+inline constexpr bool has_fft_engine<SetharesModel> = true;
+template <>
+inline constexpr bool has_fft_engine<ProductModel> = true;
+
+/// Settings trading the speed of the FFT engine for its accuracy.
+struct FftEngineSettings
+{
+	/// Spacing of the logarithmic frequency grid, in natural log units.
+	double resolution = std::numbers::ln2 / 12000.0;
+
+	/** Largest change within a band of the log of the roughness scale factor.
+	 *
+	 * The factor depends on the lesser frequency of each pair, which is
+	 * approximated by the center of the band of the stable partial.
+	 */
+	double band_tolerance = 0.1;
+
+	/** Number of amplitudes at which the minimum weighting is exact.
+	 *
+	 * Between them, it is interpolated linearly in the stable amplitude.
+	 */
+	std::size_t amplitude_thresholds = 24;
+};
+
+/** Approximate the dissonance curve at each of `intervals` with FFTs.
+ *
+ * Both timbres are binned on a logarithmic frequency grid, where raising by an
+ * interval is a translation, so the whole curve is a cross-correlation of the
+ * binned timbres with the roughness of a pair of partials. The stable partials
+ * are split into bands, each with its own roughness kernel, to account for
+ * the dependence of roughness on the lesser frequency. The weighting is
+ * interpolated between amplitude thresholds, so that each threshold only
+ * weights the mobile partials.
+ *
+ * This takes `O(B log B)` time for each band and threshold, where `B` is the
+ * number of grid points spanning the partials and intervals, rather than
+ * time proportional to the product of the numbers of partials and intervals.
+ * Instantiations exist for models where `has_fft_engine` is true.
+ */
+template <DissonanceModelPolicy Model>
+[[nodiscard]]
+auto compute_dissonance_curve_fft(
+	std::span<Partial const> stable_partials,
+	std::span<Partial const> mobile_partials,
+	std::span<double const> intervals,
+	FftEngineSettings const& settings = {}
+) -> std::vector<double>;
+} // namespace disscalc
+
+#endif
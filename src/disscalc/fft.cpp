@@ -0,0 +1,64 @@
+#include "disscalc/fft.hpp"
+
+#include <cassert>
+#include <numbers>
+#include <utility>
+
+namespace disscalc
+{
+// Reorder `data` so each element is at the bit-reversal of its index.
+static
+void bit_reverse_permute(std::span<std::complex<double>> data) noexcept
+{
+	std::size_t const n = data.size();
+	for (std::size_t i = 1, j = 0; i < n; ++i)
+	{
+		std::size_t bit = n >> 1;
+		for (; (j & bit) != 0; bit >>= 1)
+		{
+			j ^= bit;
+		}
+		j ^= bit;
+
+		if (i < j)
+		{
+			std::swap(data[i], data[j]);
+		}
+	}
+}
+
+void fft(std::span<std::complex<double>> data, bool inverse) noexcept
+{
+	assert(is_power_of_two(data.size()));
+
+	bit_reverse_permute(data);
+
+	double const sign = inverse ? 1.0 : -1.0;
+	for (std::size_t length = 2; length <= data.size(); length <<= 1)
+	{
+		double const angle =
+			sign * 2.0 * std::numbers::pi / static_cast<double>(length);
+
+		/*
+		 * Each twiddle factor is computed directly rather than by repeated
+		 * multiplication, which would accumulate rounding error.
+		 */
+		for (std::size_t k = 0; k < length / 2; ++k)
+		{
+			auto const twiddle =
+				std::polar(1.0, angle * static_cast<double>(k));
+			for (
+				std::size_t first = 0;
+				first < data.size();
+				first += length
+			)
+			{
+				auto const even = data[first + k];
+				auto const odd = data[first + k + length / 2] * twiddle;
+				data[first + k] = even + odd;
+				data[first + k + length / 2] = even - odd;
+			}
+		}
+	}
+}
+} // namespace disscalc
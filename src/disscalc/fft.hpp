@@ -0,0 +1,29 @@
+#ifndef DISSCALC_FFT_HPP_INCLUDED
+#define DISSCALC_FFT_HPP_INCLUDED
+
+#include <complex>
+#include <cstddef>
+#include <span>
+
+namespace disscalc
+{
+/// Indicate whether `n` is a power of two, which is required for FFT sizes.
+[[nodiscard]] constexpr
+bool is_power_of_two(std::size_t n) noexcept
+{
+	return n != 0 && (n & (n - 1)) == 0;
+}
+
+/** Compute the discrete Fourier transform of `data` in place.
+ *
+ * The size of `data` must be a power of two. The transform is unnormalized,
+ * so applying the inverse transform afterward scales the data by its size.
+ *
+ * @param data the sequence to transform.
+ *
+ * @param inverse whether to compute the inverse transform instead.
+ */
+void fft(std::span<std::complex<double>> data, bool inverse = false) noexcept;
+} // namespace disscalc
+
+#endif
@@ -0,0 +1,137 @@
+#include "disscalc/frames.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <system_error>
+
+namespace disscalc
+{
+[[nodiscard]]
+auto parse_timbre_line(std::string_view line)
+	-> std::optional<std::vector<Partial>>
+{
+	constexpr std::string_view whitespace = " \t\r";
+
+	std::vector<double> values;
+	for (
+		auto start = line.find_first_not_of(whitespace);
+		start != std::string_view::npos;
+		start = line.find_first_not_of(whitespace, start)
+	)
+	{
+		auto const end = std::min(
+			line.find_first_of(whitespace, start),
+			line.size()
+		);
+
+		double value;
+		auto const [parsed_end, error] = std::from_chars(
+			line.data() + start,
+			line.data() + end,
+			value
+		);
+		if (
+			error != std::errc()
+			|| parsed_end != line.data() + end
+			|| !(value > 0.0)
+		)
+		{
+			return std::nullopt;
+		}
+
+		values.push_back(value);
+		start = end;
+	}
+
+	if (values.size() % 2 != 0)
+	{
+		return std::nullopt;
+	}
+
+	std::vector<Partial> partials;
+	partials.reserve(values.size() / 2);
+	for (std::size_t i = 0; i < values.size(); i += 2)
+	{
+		partials.push_back({values[i], values[i + 1]});
+	}
+	return partials;
+}
+
+[[nodiscard]]
+auto TimbreFrameReader::next(void) -> std::optional<TimbreFrame>
+{
+	if (error_line_.has_value())
+	{
+		return std::nullopt;
+	}
+
+	while (std::getline(in_, line_))
+	{
+		++line_number_;
+
+		auto const first = line_.find_first_not_of(" \t\r");
+		if (first == std::string::npos || line_[first] == '#')
+		{
+			continue;
+		}
+
+		auto partials = parse_timbre_line(line_);
+		if (!partials.has_value())
+		{
+			error_line_ = line_number_;
+			return std::nullopt;
+		}
+		return TimbreFrame{frame_count_++, std::move(*partials)};
+	}
+
+	return std::nullopt;
+}
+
+[[nodiscard]]
+bool timbres_are_similar(
+	std::span<Partial const> a,
+	std::span<Partial const> b,
+	double tolerance
+) noexcept
+{
+	if (a.size() != b.size())
+	{
+		return false;
+	}
+
+	auto const close = [&](double x, double y) noexcept
+	{
+		return std::abs(x - y) <= tolerance * std::abs(y);
+	};
+	for (std::size_t i = 0; i < a.size(); ++i)
+	{
+		if (
+			!close(a[i].frequency, b[i].frequency)
+			|| !close(a[i].amplitude, b[i].amplitude)
+		)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+[[nodiscard]]
+auto find_local_minima(std::span<TableRow const> rows)
+	-> std::vector<TableRow>
+{
+	std::vector<TableRow> minima;
+	for (std::size_t i = 1; i + 1 < rows.size(); ++i)
+	{
+		if (
+			rows[i].output < rows[i - 1].output
+			&& rows[i].output <= rows[i + 1].output
+		)
+		{
+			minima.push_back(rows[i]);
+		}
+	}
+	return minima;
+}
+} // namespace disscalc
@@ -0,0 +1,120 @@
+#ifndef DISSCALC_FRAMES_HPP_INCLUDED
+#define DISSCALC_FRAMES_HPP_INCLUDED
+
+#include "disscalc/partial.hpp"
+#include "disscalc/table.hpp"
+
+#include <cstddef>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace disscalc
+{
+/// What is output for each frame of a time-varying timbre.
+enum struct FrameSummary
+{
+	curve, ///< Every row of the dissonance curve.
+	minima, ///< Only the rows at local minima of the curve.
+};
+
+/// Find the summary with the given name.
+[[nodiscard]] constexpr
+auto find_frame_summary(std::string_view name) noexcept
+	-> std::optional<FrameSummary>
+{
+	if (name == "curve")
+	{
+		return FrameSummary::curve;
+	}
+	if (name == "minima")
+	{
+		return FrameSummary::minima;
+	}
+	return std::nullopt;
+}
+
+/** Parse a timbre written as alternating frequencies and amplitudes.
+ *
+ * Values are separated by whitespace, such as "220 1 440 0.5" for two
+ * partials. Every value must be positive.
+ *
+ * @return the partials, or an empty optional if `line` is malformed.
+ */
+[[nodiscard]]
+auto parse_timbre_line(std::string_view line)
+	-> std::optional<std::vector<Partial>>;
+
+/// The timbre of a sound at one point in time.
+struct TimbreFrame
+{
+	/// Position of the frame in the stream, counting from zero.
+	std::size_t index;
+
+	std::vector<Partial> partials;
+};
+
+/** Reader for a stream of timbre frames, one per line.
+ *
+ * Each line is parsed with `parse_timbre_line`. Blank lines and lines starting
+ * with '#' are skipped. Only one line is held at a time.
+ */
+class TimbreFrameReader
+{
+public:
+	/// Create a reader for `in`, which must outlive it.
+	explicit TimbreFrameReader(std::istream& in)
+		: in_(in)
+	{}
+
+	/** Read the next frame.
+	 *
+	 * @return the frame, or an empty optional at the end of the stream or
+	 * at a malformed line.
+	 */
+	[[nodiscard]]
+	auto next(void) -> std::optional<TimbreFrame>;
+
+	/// Get the number of the malformed line that stopped reading, if any.
+	[[nodiscard]]
+	auto error_line(void) const noexcept -> std::optional<std::size_t>
+	{
+		return error_line_;
+	}
+
+private:
+	std::istream& in_;
+	std::string line_;
+	std::size_t line_number_ = 0;
+	std::size_t frame_count_ = 0;
+	std::optional<std::size_t> error_line_;
+};
+
+/** Indicate whether two timbres barely differ.
+ *
+ * They must have the same number of partials, and the frequency and amplitude
+ * of each partial must be within `tolerance` of the other's, relative to the
+ * other's value.
+ */
+[[nodiscard]]
+bool timbres_are_similar(
+	std::span<Partial const> a,
+	std::span<Partial const> b,
+	double tolerance
+) noexcept;
+
+/** Get the rows of a curve that are local minima.
+ *
+ * A row is a local minimum if its output is less than that of the row before
+ * it and no greater than that of the row after it. The first and last rows are
+ * never local minima.
+ */
+[[nodiscard]]
+auto find_local_minima(std::span<TableRow const> rows)
+	-> std::vector<TableRow>;
+} // namespace disscalc
+
+#endif
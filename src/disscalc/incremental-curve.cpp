@@ -0,0 +1,171 @@
+#include "disscalc/incremental-curve.hpp"
+
+#include "disscalc/blocked-engine.hpp"
+#include "disscalc/parallel.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace disscalc
+{
+template <DissonanceModelPolicy Model>
+IncrementalCurve<Model>::IncrementalCurve(
+	std::vector<Partial> stable_partials,
+	std::vector<Partial> mobile_partials,
+	std::vector<double> intervals,
+	std::size_t thread_count,
+	std::size_t rebuild_interval
+)
+	: stable_(std::move(stable_partials)),
+	mobile_(std::move(mobile_partials)),
+	shared_(false),
+	intervals_(std::move(intervals)),
+	dissonances_(intervals_.size()),
+	thread_count_(thread_count),
+	rebuild_interval_(rebuild_interval)
+{
+	rebuild();
+}
+
+template <DissonanceModelPolicy Model>
+IncrementalCurve<Model>::IncrementalCurve(
+	std::vector<Partial> partials,
+	std::vector<double> intervals,
+	std::size_t thread_count,
+	std::size_t rebuild_interval
+)
+	: stable_(std::move(partials)),
+	shared_(true),
+	intervals_(std::move(intervals)),
+	dissonances_(intervals_.size()),
+	thread_count_(thread_count),
+	rebuild_interval_(rebuild_interval)
+{
+	rebuild();
+}
+
+template <DissonanceModelPolicy Model>
+void IncrementalCurve<Model>::add_partial(TimbreSide side, Partial partial)
+{
+	auto& partials = side_partials(side);
+	partials.push_back(partial);
+	apply_partial(side, partials.size() - 1, 1.0);
+	finish_update();
+}
+
+template <DissonanceModelPolicy Model>
+void IncrementalCurve<Model>::remove_partial(
+	TimbreSide side,
+	std::size_t index
+)
+{
+	auto& partials = side_partials(side);
+	assert(index < partials.size());
+
+	apply_partial(side, index, -1.0);
+	partials.erase(partials.begin() + static_cast<std::ptrdiff_t>(index));
+	finish_update();
+}
+
+template <DissonanceModelPolicy Model>
+void IncrementalCurve<Model>::set_partial(
+	TimbreSide side,
+	std::size_t index,
+	Partial partial
+)
+{
+	auto& partials = side_partials(side);
+	assert(index < partials.size());
+
+	apply_partial(side, index, -1.0);
+	partials[index] = partial;
+	apply_partial(side, index, 1.0);
+	finish_update();
+}
+
+template <DissonanceModelPolicy Model>
+void IncrementalCurve<Model>::rebuild(void)
+{
+	compute_dissonance_curve_blocked<Model>(
+		stable_,
+		shared_ ? stable_ : mobile_,
+		intervals_,
+		dissonances_,
+		thread_count_
+	);
+	updates_since_rebuild_ = 0;
+}
+
+// Number of intervals updated together by one thread.
+constexpr std::size_t incremental_interval_tile = 64;
+
+template <DissonanceModelPolicy Model>
+void IncrementalCurve<Model>::apply_partial(
+	TimbreSide side,
+	std::size_t index,
+	double sign
+)
+{
+	auto const partial = side_partials(side)[index];
+	bool const is_stable = shared_ || side == TimbreSide::stable;
+	bool const is_mobile = shared_ || side == TimbreSide::mobile;
+	std::span<Partial const> const others = shared_
+		? stable_
+		: side == TimbreSide::stable ? mobile_ : stable_;
+
+	auto const tile_count = (intervals_.size() + incremental_interval_tile - 1)
+		/ incremental_interval_tile;
+	parallel_for(tile_count, thread_count_, [&](std::size_t tile) noexcept
+	{
+		auto const first = tile * incremental_interval_tile;
+		auto const last = std::min(
+			first + incremental_interval_tile,
+			intervals_.size()
+		);
+		for (auto r = first; r < last; ++r)
+		{
+			double const interval = intervals_[r];
+			double sum = 0.0;
+			for (std::size_t i = 0; i < others.size(); ++i)
+			{
+				auto const other = others[i];
+				if (is_stable)
+				{
+					sum += compute_dissonance_between_partials<Model>(
+						partial,
+						{other.frequency * interval, other.amplitude}
+					);
+				}
+
+				/*
+				 * A shared partial is also raised against every partial, but
+				 * its pairing with itself was already counted.
+				 */
+				if (is_mobile && !(shared_ && i == index))
+				{
+					sum += compute_dissonance_between_partials<Model>(
+						other,
+						{partial.frequency * interval, partial.amplitude}
+					);
+				}
+			}
+			dissonances_[r] += sign * sum;
+		}
+	});
+}
+
+template <DissonanceModelPolicy Model>
+void IncrementalCurve<Model>::finish_update(void)
+{
+	++updates_since_rebuild_;
+	if (updates_since_rebuild_ >= rebuild_interval_)
+	{
+		rebuild();
+	}
+}
+
+template class IncrementalCurve<SetharesModel>;
+template class IncrementalCurve<ProductModel>;
+template class IncrementalCurve<VassilakisModel>;
+} // namespace disscalc
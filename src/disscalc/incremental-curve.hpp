@@ -0,0 +1,139 @@
+#ifndef DISSCALC_INCREMENTAL_CURVE_HPP_INCLUDED
+#define DISSCALC_INCREMENTAL_CURVE_HPP_INCLUDED
+
+#include "disscalc/models.hpp"
+#include "disscalc/partial.hpp"
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace disscalc
+{
+/// Which of the two timbres of an interval a partial belongs to.
+enum struct TimbreSide
+{
+	stable,
+	mobile,
+};
+
+/// Default number of updates after which an incremental curve is rebuilt.
+constexpr std::size_t incremental_rebuild_interval = 1000;
+
+/** Dissonance curve of two timbres, kept up to date as partials change.
+ *
+ * The dissonance at each interval is a sum over pairs of partials, so adding,
+ * removing or changing one partial only needs the terms pairing it with every
+ * partial of the other timbre, which are added to or subtracted from the
+ * stored curve. Rounding errors build up with each update, so the whole curve
+ * is recomputed after a given number of updates, and the curve is then
+ * exactly that of `compute_dissonance`.
+ *
+ * When the timbres are shared, the same partials make up both timbres, so
+ * either side refers to them. Instantiations exist for every model in
+ * `DissonanceModel`.
+ */
+template <DissonanceModelPolicy Model>
+class IncrementalCurve
+{
+public:
+	/** Compute the curve of two separate timbres.
+	 *
+	 * @param thread_count the maximum number of threads used by each update,
+	 * as for `parallel_for`.
+	 *
+	 * @param rebuild_interval the number of updates after which the curve is
+	 * recomputed from scratch.
+	 */
+	IncrementalCurve(
+		std::vector<Partial> stable_partials,
+		std::vector<Partial> mobile_partials,
+		std::vector<double> intervals,
+		std::size_t thread_count = 1,
+		std::size_t rebuild_interval = incremental_rebuild_interval
+	);
+
+	/// Compute the curve of a timbre with itself.
+	IncrementalCurve(
+		std::vector<Partial> partials,
+		std::vector<double> intervals,
+		std::size_t thread_count = 1,
+		std::size_t rebuild_interval = incremental_rebuild_interval
+	);
+
+	/// Get the dissonance at each interval.
+	[[nodiscard]]
+	auto dissonances(void) const noexcept -> std::span<double const>
+	{
+		return dissonances_;
+	}
+
+	[[nodiscard]]
+	auto intervals(void) const noexcept -> std::span<double const>
+	{
+		return intervals_;
+	}
+
+	/// Get the current partials of one side.
+	[[nodiscard]]
+	auto partials(TimbreSide side) const noexcept -> std::span<Partial const>
+	{
+		return side_partials(side);
+	}
+
+	/// Add a partial to the end of one side.
+	void add_partial(TimbreSide side, Partial partial);
+
+	/// Remove the partial at `index` of one side, keeping the others in order.
+	void remove_partial(TimbreSide side, std::size_t index);
+
+	/// Replace the partial at `index` of one side.
+	void set_partial(TimbreSide side, std::size_t index, Partial partial);
+
+	/// Recompute the whole curve from scratch.
+	void rebuild(void);
+
+	/// Get the number of updates since the curve was last computed in full.
+	[[nodiscard]]
+	std::size_t updates_since_rebuild(void) const noexcept
+	{
+		return updates_since_rebuild_;
+	}
+
+private:
+	[[nodiscard]]
+	auto side_partials(TimbreSide side) noexcept -> std::vector<Partial>&
+	{
+		return shared_ || side == TimbreSide::stable ? stable_ : mobile_;
+	}
+
+	[[nodiscard]]
+	auto side_partials(TimbreSide side) const noexcept
+		-> std::vector<Partial> const&
+	{
+		return shared_ || side == TimbreSide::stable ? stable_ : mobile_;
+	}
+
+	/*
+	 * Add `sign` times every term involving the partial at `index` of one
+	 * side to the curve.
+	 */
+	void apply_partial(TimbreSide side, std::size_t index, double sign);
+
+	// Count an update, rebuilding the curve if there have been enough.
+	void finish_update(void);
+
+	std::vector<Partial> stable_;
+	std::vector<Partial> mobile_;
+	bool shared_;
+
+	std::vector<double> intervals_;
+	std::vector<double> dissonances_;
+
+	std::size_t thread_count_;
+	std::size_t rebuild_interval_;
+	std::size_t updates_since_rebuild_ = 0;
+};
+} // namespace disscalc
+
+#endif
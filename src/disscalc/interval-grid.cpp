@@ -0,0 +1,134 @@
+#include "disscalc/interval-grid.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace disscalc
+{
+// Greatest number of steps in a grid, beyond which steps are not distinct.
+constexpr double max_grid_steps = 0x1p53;
+
+[[nodiscard]] static
+double get_step(double first, double delta, std::size_t step) noexcept
+{
+	return first + static_cast<double>(step) * delta;
+}
+
+// Clamp an estimated number of steps to `[0, count]`.
+[[nodiscard]] static
+std::size_t clamp_steps(double estimate, std::size_t count) noexcept
+{
+	if (!(estimate > 0.0))
+	{
+		return 0;
+	}
+	if (estimate >= static_cast<double>(count))
+	{
+		return count;
+	}
+	return static_cast<std::size_t>(estimate);
+}
+
+// Count the steps of a grid, estimating the count by division and then
+// correcting it so it agrees with the values actually computed.
+[[nodiscard]] static
+std::size_t count_steps(double first, double delta, double last) noexcept
+{
+	double const limit = last + grid_end_tolerance * delta;
+	if (!(first <= limit))
+	{
+		return 0;
+	}
+
+	auto const max_steps = static_cast<std::size_t>(max_grid_steps);
+	auto steps = clamp_steps(
+		std::floor((limit - first) / delta) + 1.0,
+		max_steps
+	);
+	while (steps > 1 && get_step(first, delta, steps - 1) > limit)
+	{
+		--steps;
+	}
+	while (steps < max_steps && get_step(first, delta, steps) <= limit)
+	{
+		++steps;
+	}
+	return steps;
+}
+
+// Count the steps of a grid less than `x`.
+[[nodiscard]] static
+std::size_t count_steps_below(
+	double first,
+	double delta,
+	std::size_t step_count,
+	double x
+) noexcept
+{
+	auto steps = clamp_steps(std::ceil((x - first) / delta), step_count);
+	while (steps > 0 && get_step(first, delta, steps - 1) >= x)
+	{
+		--steps;
+	}
+	while (steps < step_count && get_step(first, delta, steps) < x)
+	{
+		++steps;
+	}
+	return steps;
+}
+
+IntervalGrid::IntervalGrid(
+	double first,
+	double delta,
+	double last,
+	std::vector<double> const& extra_values
+)
+	: first_(first),
+	delta_(delta),
+	step_count_(count_steps(first, delta, last))
+{
+	for (auto const x : extra_values)
+	{
+		auto const steps_below = count_steps_below(
+			first_,
+			delta_,
+			step_count_,
+			x
+		);
+
+		// Skip values that are already steps.
+		if (steps_below < step_count_
+			&& get_step(first_, delta_, steps_below) == x)
+		{
+			continue;
+		}
+
+		extra_rows_.push_back(steps_below + extra_values_.size());
+		extra_values_.push_back(x);
+	}
+}
+
+TableInput IntervalGrid::operator[](std::size_t row) const noexcept
+{
+	// The extra values at or before the row.
+	auto const after = std::ranges::upper_bound(extra_rows_, row);
+	auto const extras_before = static_cast<std::size_t>(
+		after - std::cbegin(extra_rows_)
+	);
+
+	if (extras_before > 0 && extra_rows_[extras_before - 1] == row)
+	{
+		return {extra_values_[extras_before - 1], true};
+	}
+	return {get_step(first_, delta_, row - extras_before), false};
+}
+
+auto IntervalGrid::rows(RowRange rows) const noexcept
+	-> std::ranges::subrange<Iterator>
+{
+	auto const last = std::min(rows.last, size());
+	auto const first = std::min(rows.first, last);
+	return {Iterator(this, first), Iterator(this, last)};
+}
+} // namespace disscalc
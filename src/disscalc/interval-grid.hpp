@@ -0,0 +1,248 @@
+#ifndef DISSCALC_INTERVAL_GRID_HPP_INCLUDED
+#define DISSCALC_INTERVAL_GRID_HPP_INCLUDED
+
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <vector>
+
+namespace disscalc
+{
+/// Half-open range of row indices in a table.
+struct RowRange
+{
+	std::size_t first;
+	std::size_t last;
+};
+
+/// A single left-side value of a table.
+struct TableInput
+{
+	double value;
+
+	/// Whether `value` came from the extra values rather than the grid.
+	bool is_extra;
+};
+
+/**
+ * Fraction of the delta by which a value of a grid may exceed its upper bound,
+ * so that rounding error does not drop an upper bound a whole number of steps
+ * from the lower bound.
+ */
+constexpr double grid_end_tolerance = 1e-9;
+
+class IntervalGrid;
+
+/// Random access iterator over the values of a grid.
+class IntervalGridIterator
+{
+public:
+	using iterator_concept = std::random_access_iterator_tag;
+	using iterator_category = std::input_iterator_tag;
+	using value_type = TableInput;
+	using difference_type = std::ptrdiff_t;
+
+	IntervalGridIterator(void) = default;
+
+	IntervalGridIterator(IntervalGrid const* grid, std::size_t row) noexcept
+		: grid_(grid),
+		row_(row)
+	{}
+
+	[[nodiscard]]
+	TableInput operator*(void) const noexcept;
+
+	[[nodiscard]]
+	TableInput operator[](difference_type n) const noexcept;
+
+	/// Index of the row the iterator refers to.
+	[[nodiscard]]
+	std::size_t row(void) const noexcept
+	{
+		return row_;
+	}
+
+	IntervalGridIterator& operator++(void) noexcept
+	{
+		++row_;
+		return *this;
+	}
+
+	IntervalGridIterator operator++(int) noexcept
+	{
+		auto const old = *this;
+		++row_;
+		return old;
+	}
+
+	IntervalGridIterator& operator--(void) noexcept
+	{
+		--row_;
+		return *this;
+	}
+
+	IntervalGridIterator operator--(int) noexcept
+	{
+		auto const old = *this;
+		--row_;
+		return old;
+	}
+
+	IntervalGridIterator& operator+=(difference_type n) noexcept
+	{
+		row_ += static_cast<std::size_t>(n);
+		return *this;
+	}
+
+	IntervalGridIterator& operator-=(difference_type n) noexcept
+	{
+		row_ -= static_cast<std::size_t>(n);
+		return *this;
+	}
+
+	[[nodiscard]]
+	friend IntervalGridIterator operator+(
+		IntervalGridIterator it,
+		difference_type n
+	) noexcept
+	{
+		return it += n;
+	}
+
+	[[nodiscard]]
+	friend IntervalGridIterator operator+(
+		difference_type n,
+		IntervalGridIterator it
+	) noexcept
+	{
+		return it += n;
+	}
+
+	[[nodiscard]]
+	friend IntervalGridIterator operator-(
+		IntervalGridIterator it,
+		difference_type n
+	) noexcept
+	{
+		return it -= n;
+	}
+
+	[[nodiscard]]
+	friend difference_type operator-(
+		IntervalGridIterator a,
+		IntervalGridIterator b
+	) noexcept
+	{
+		return static_cast<difference_type>(a.row_ - b.row_);
+	}
+
+	[[nodiscard]]
+	friend bool operator==(
+		IntervalGridIterator a,
+		IntervalGridIterator b
+	) noexcept
+	{
+		return a.row_ == b.row_;
+	}
+
+	[[nodiscard]]
+	friend auto operator<=>(
+		IntervalGridIterator a,
+		IntervalGridIterator b
+	) noexcept
+	{
+		return a.row_ <=> b.row_;
+	}
+
+private:
+	IntervalGrid const* grid_ = nullptr;
+	std::size_t row_ = 0;
+};
+
+/** The left-side values of a table as a random access range.
+ *
+ * The values are `first + i * delta` for each natural number `i` up to the
+ * greatest one placing the value at most `last` (to within
+ * `grid_end_tolerance` of a step), merged in order with any extra values not
+ * already among them. Each value is computed from its index when it is read,
+ * so no list of values is ever built, and reading a value takes constant time
+ * without extra values, and time logarithmic in their number with them.
+ */
+class IntervalGrid
+{
+public:
+	using Iterator = IntervalGridIterator;
+
+	/** Create the grid of a table.
+	 *
+	 * `extra_values` must be sorted without duplicates. Only the extra values
+	 * are copied, so creating a grid takes time proportional to their number
+	 * and not to the number of steps.
+	 */
+	IntervalGrid(
+		double first,
+		double delta,
+		double last,
+		std::vector<double> const& extra_values
+	);
+
+	/// Total number of values, including extra values.
+	[[nodiscard]]
+	std::size_t size(void) const noexcept
+	{
+		return step_count_ + extra_values_.size();
+	}
+
+	/// Number of values in `[first, last]`, not counting extra values.
+	[[nodiscard]]
+	std::size_t step_count(void) const noexcept
+	{
+		return step_count_;
+	}
+
+	/// Get the value of the given row, which must be less than `size()`.
+	[[nodiscard]]
+	TableInput operator[](std::size_t row) const noexcept;
+
+	[[nodiscard]]
+	Iterator begin(void) const noexcept
+	{
+		return {this, 0};
+	}
+
+	[[nodiscard]]
+	Iterator end(void) const noexcept
+	{
+		return {this, size()};
+	}
+
+	/// Get the values of the rows within `rows`, clamped to the grid.
+	[[nodiscard]]
+	auto rows(RowRange rows) const noexcept
+		-> std::ranges::subrange<Iterator>;
+
+private:
+	double first_;
+	double delta_;
+	std::size_t step_count_;
+
+	// Extra values that are not also steps, and the row of each.
+	std::vector<double> extra_values_;
+	std::vector<std::size_t> extra_rows_;
+};
+
+inline
+TableInput IntervalGridIterator::operator*(void) const noexcept
+{
+	return (*grid_)[row_];
+}
+
+inline
+TableInput IntervalGridIterator::operator[](difference_type n) const noexcept
+{
+	return (*grid_)[row_ + static_cast<std::size_t>(n)];
+}
+} // namespace disscalc
+
+#endif
@@ -0,0 +1,241 @@
+#ifndef DISSCALC_MODELS_HPP_INCLUDED
+#define DISSCALC_MODELS_HPP_INCLUDED
+
+#include "disscalc/partial.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+namespace disscalc
+{
+/*
+ * A dissonance model is a type with static members describing the dissonance
+ * of two partials. The dissonance is
+ *
+ *     weight(a, b) * (c1 * exp(a1 * x) + c2 * exp(a2 * x))
+ *
+ * where x = dstar * |f_b - f_a| / (s1 * min(f_a, f_b) + s2), f_a and f_b are
+ * the frequencies of the partials, and a and b are their amplitudes.
+ * `weight_slope(a, b)` is the derivative of the weight with respect to `a`.
+ *
+ * Models are used as template arguments, so each model gets its own
+ * instantiation of the kernel with every constant and the weighting inlined.
+ */
+template <typename Model>
+concept DissonanceModelPolicy = requires(double amp)
+{
+	{ Model::name } -> std::convertible_to<std::string_view>;
+	{ Model::dstar } -> std::convertible_to<double>;
+	{ Model::s1 } -> std::convertible_to<double>;
+	{ Model::s2 } -> std::convertible_to<double>;
+	{ Model::c1 } -> std::convertible_to<double>;
+	{ Model::c2 } -> std::convertible_to<double>;
+	{ Model::a1 } -> std::convertible_to<double>;
+	{ Model::a2 } -> std::convertible_to<double>;
+	{ Model::weight(amp, amp) } noexcept -> std::same_as<double>;
+	{ Model::weight_slope(amp, amp) } noexcept -> std::same_as<double>;
+};
+
+/// Sethares' fit of the Plomp–Levelt curve, weighted by the lesser amplitude.
+struct SetharesModel
+{
+	static constexpr std::string_view name = "sethares";
+
+	// Magic numbers not explained in the original program.
+	static constexpr double dstar = 0.24;
+	static constexpr double s1 = 0.0207;
+	static constexpr double s2 = 18.96;
+	static constexpr double c1 = 5.0;
+	static constexpr double c2 = -5.0;
+	static constexpr double a1 = -3.51;
+	static constexpr double a2 = -5.75;
+
+	[[nodiscard]] static constexpr
+	double weight(double amp_a, double amp_b) noexcept
+	{
+		return std::min(amp_a, amp_b);
+	}
+
+	// Where the amplitudes are equal, each gets half of the slope.
+	[[nodiscard]] static constexpr
+	double weight_slope(double amp_a, double amp_b) noexcept
+	{
+		return amp_a < amp_b ? 1.0 : amp_a > amp_b ? 0.0 : 0.5;
+	}
+};
+
+/// The Sethares curve weighted by the product of the amplitudes.
+struct ProductModel : SetharesModel
+{
+	static constexpr std::string_view name = "product";
+
+	[[nodiscard]] static constexpr
+	double weight(double amp_a, double amp_b) noexcept
+	{
+		return amp_a * amp_b;
+	}
+
+	[[nodiscard]] static constexpr
+	double weight_slope(double, double amp_b) noexcept
+	{
+		return amp_b;
+	}
+};
+
+/** Vassilakis' roughness model.
+ *
+ * The weighting accounts for both the loudness of the pair, through the
+ * product of the amplitudes, and the degree of amplitude fluctuation, which
+ * is greatest when the amplitudes are equal.
+ */
+struct VassilakisModel
+{
+	static constexpr std::string_view name = "vassilakis";
+
+	static constexpr double dstar = 0.24;
+	static constexpr double s1 = 0.0207;
+	static constexpr double s2 = 18.96;
+	static constexpr double c1 = 1.0;
+	static constexpr double c2 = -1.0;
+	static constexpr double a1 = -3.5;
+	static constexpr double a2 = -5.75;
+
+	[[nodiscard]] static
+	double weight(double amp_a, double amp_b) noexcept
+	{
+		double const sum = amp_a + amp_b;
+		double const evenness = 2.0 * std::min(amp_a, amp_b) / sum;
+		return 0.5 * std::pow(amp_a * amp_b, 0.1) * std::pow(evenness, 3.11);
+	}
+
+	[[nodiscard]] static
+	double weight_slope(double amp_a, double amp_b) noexcept
+	{
+		// Derivative of the logarithm of the evenness.
+		double const evenness_slope = amp_a < amp_b
+			? 1.0 / amp_a
+			: amp_a > amp_b ? 0.0 : 0.5 / amp_a;
+		double const log_slope = 0.1 / amp_a
+			+ 3.11 * (evenness_slope - 1.0 / (amp_a + amp_b));
+		return weight(amp_a, amp_b) * log_slope;
+	}
+};
+
+/// Dissonance models selectable at run time.
+enum struct DissonanceModel
+{
+	sethares,
+	product,
+	vassilakis,
+};
+
+/// Find the model with the given name.
+[[nodiscard]] constexpr
+auto find_dissonance_model(std::string_view name) noexcept
+	-> std::optional<DissonanceModel>
+{
+	if (name == SetharesModel::name)
+	{
+		return DissonanceModel::sethares;
+	}
+	if (name == ProductModel::name)
+	{
+		return DissonanceModel::product;
+	}
+	if (name == VassilakisModel::name)
+	{
+		return DissonanceModel::vassilakis;
+	}
+	return std::nullopt;
+}
+
+/** Call `func` with a default-constructed policy type for `model`.
+ *
+ * This is the only place the run-time choice of model is resolved, so
+ * everything below `func` works with a compile-time model.
+ */
+decltype(auto) visit_dissonance_model(DissonanceModel model, auto&& func)
+{
+	switch (model)
+	{
+	case DissonanceModel::product:
+		return std::forward<decltype(func)>(func)(ProductModel{});
+
+	case DissonanceModel::vassilakis:
+		return std::forward<decltype(func)>(func)(VassilakisModel{});
+
+	case DissonanceModel::sethares:
+	default:
+		return std::forward<decltype(func)>(func)(SetharesModel{});
+	}
+}
+
+/// `exp(arg)`, or zero where `arg` is too negative for the result to matter.
+[[nodiscard]] constexpr
+double roughness_exp(double arg) noexcept
+{
+	return arg < -88 ? 0 : std::exp(arg);
+}
+
+/** Unweighted dissonance of a pair of partials under `Model`.
+ *
+ * This is `c1 * exp(a1 * s * d) + c2 * exp(a2 * s * d)` for the distance `d`
+ * between the partials and its scale `s`. Each coefficient is multiplied by the
+ * scale before the distance, since exported tables depend on the rounding.
+ */
+template <DissonanceModelPolicy Model>
+[[nodiscard]] constexpr
+double roughness_curve(double s, double d) noexcept
+{
+	return Model::c1 * roughness_exp(Model::a1 * s * d)
+		+ Model::c2 * roughness_exp(Model::a2 * s * d);
+}
+
+/// `roughness_curve` as a function of the scaled distance `x` alone.
+template <DissonanceModelPolicy Model>
+[[nodiscard]] constexpr
+double roughness_curve(double x) noexcept
+{
+	return roughness_curve<Model>(1.0, x);
+}
+
+/// Derivative of `roughness_curve`.
+template <DissonanceModelPolicy Model>
+[[nodiscard]] constexpr
+double roughness_curve_slope(double x) noexcept
+{
+	return Model::c1 * Model::a1 * roughness_exp(Model::a1 * x)
+		+ Model::c2 * Model::a2 * roughness_exp(Model::a2 * x);
+}
+
+/** Compute the unweighted dissonance between two frequencies under `Model`.
+ *
+ * Multiplying this by `Model::weight` of the amplitudes gives exactly the
+ * result of `compute_dissonance_between_partials`.
+ */
+template <DissonanceModelPolicy Model>
+[[nodiscard]] constexpr
+double compute_roughness(double freq_a, double freq_b) noexcept
+{
+	double const least_freq = std::min(freq_a, freq_b);
+	double const freq_diff = std::abs(freq_b - freq_a);
+
+	double const s = Model::dstar / (Model::s1 * least_freq + Model::s2);
+	return roughness_curve<Model>(s, freq_diff);
+}
+
+/// Compute the dissonance between two partials under `Model`.
+template <DissonanceModelPolicy Model>
+[[nodiscard]] constexpr
+double compute_dissonance_between_partials(Partial a, Partial b) noexcept
+{
+	double const weight = Model::weight(a.amplitude, b.amplitude);
+	return weight * compute_roughness<Model>(a.frequency, b.frequency);
+}
+} // namespace disscalc
+
+#endif
@@ -1,7 +1,11 @@
 #include "disscalc/options.hpp"
 
+#include "disscalc/fft.hpp"
+
 #include <algorithm>
 #include <cassert>
+#include <charconv>
+#include <system_error>
 
 namespace disscalc
 {
@@ -19,6 +23,53 @@ char ProgramOptions::delimiter(void) const noexcept
 	return '?';
 }
 
+[[nodiscard]]
+DissonanceModel ProgramOptions::model(void) const noexcept
+{
+	if (!model_name_.has_value())
+	{
+		return DissonanceModel::sethares;
+	}
+	return find_dissonance_model(*model_name_)
+		.value_or(DissonanceModel::sethares);
+}
+
+[[nodiscard]]
+Engine ProgramOptions::engine(void) const noexcept
+{
+	if (!engine_name_.has_value())
+	{
+		return Engine::exact;
+	}
+	return find_engine(*engine_name_).value_or(Engine::exact);
+}
+
+[[nodiscard]]
+FrameSummary ProgramOptions::frame_summary(void) const noexcept
+{
+	if (!frame_summary_name_.has_value())
+	{
+		return FrameSummary::curve;
+	}
+	return find_frame_summary(*frame_summary_name_)
+		.value_or(FrameSummary::curve);
+}
+
+[[nodiscard]]
+auto ProgramOptions::optimization_settings(void) const noexcept
+	-> TimbreOptimizationSettings
+{
+	auto const parameters = optimize_name_.has_value()
+		? find_optimized_parameters(*optimize_name_)
+		: std::nullopt;
+	return {
+		parameters.value_or(OptimizedParameters::frequencies),
+		frequency_range_,
+		amplitude_range_,
+		optimize_iterations_
+	};
+}
+
 [[nodiscard]] static
 auto create_partials(
 	std::span<double const> frequencies,
@@ -77,12 +128,73 @@ auto parse_double(std::string_view str) noexcept -> std::optional<double>
 	return result;
 }
 
-void ProgramOptions::add_error(std::string_view text, CommandLineErrorType type)
+[[nodiscard]]
+auto parse_size(std::string_view str) noexcept -> std::optional<std::size_t>
+{
+	std::size_t result;
+	auto const [end, error] = std::from_chars(
+		str.data(),
+		str.data() + str.size(),
+		result
+	);
+
+	// The entire string must match to be valid.
+	if (error != std::errc() || end != str.data() + str.size())
+	{
+		return std::nullopt;
+	}
+
+	return result;
+}
+
+void ProgramOptions::add_error(
+	std::string_view text,
+	CommandLineErrorType type,
+	std::string_view conflicting_text
+)
 {
-	errors_.emplace_back(text, type);
+	errors_.emplace_back(text, type, conflicting_text);
 	valid_ = false;
 }
 
+void ProgramOptions::add_conflict_error(
+	UsedOption option,
+	std::span<UsedOption const> others
+)
+{
+	if (!option.is_used)
+	{
+		return;
+	}
+
+	auto const other = std::ranges::find_if(others, &UsedOption::is_used);
+	if (other != std::ranges::end(others))
+	{
+		add_error(
+			option.name,
+			CommandLineErrorType::conflicting,
+			other->name
+		);
+	}
+}
+
+auto ProgramOptions::alternative_modes(void) const noexcept
+	-> std::array<UsedOption, 5>
+{
+	return {{
+		{"--scale or --edo", evaluates_scales()},
+		{"--frames", frames_file_.has_value()},
+		{"--sweep", sweep_.has_value()},
+		{"--chords", chords_file_.has_value()},
+		{"--mobile-timbres", mobile_timbres_file_.has_value()},
+	}};
+}
+
+bool ProgramOptions::writes_plain_table(void) const noexcept
+{
+	return std::ranges::none_of(alternative_modes(), &UsedOption::is_used);
+}
+
 void ProgramOptions::apply_option(ParsedOption const& parsed_option)
 {
 	std::string_view const flag = parsed_option.flag;
@@ -106,6 +218,33 @@ void ProgramOptions::apply_option(ParsedOption const& parsed_option)
 	{
 		try_set_string_option(format_, parsed_option);
 	}
+	else if (flag == "--cpp-namespace")
+	{
+		if (ensure_has_single_value(parsed_option))
+		{
+			cpp_header_settings_.namespace_name = parsed_option.values.front();
+		}
+	}
+	else if (flag == "--cpp-interpolation")
+	{
+		cpp_header_settings_.interpolation = true;
+	}
+	else if (flag == "--curve-tolerance")
+	{
+		try_set_double_option(curve_tolerance_, parsed_option);
+	}
+	else if (flag == "--curve-degree")
+	{
+		try_set_size_option(curve_degree_, parsed_option);
+	}
+	else if (flag == "--model" || flag == "-m")
+	{
+		try_set_string_option(model_name_, parsed_option);
+	}
+	else if (flag == "--engine")
+	{
+		try_set_string_option(engine_name_, parsed_option);
+	}
 	else if (flag == "--start" || flag == "-s")
 	{
 		try_set_double_option(start_, parsed_option);
@@ -118,6 +257,113 @@ void ProgramOptions::apply_option(ParsedOption const& parsed_option)
 	{
 		try_set_double_option(end_, parsed_option);
 	}
+	else if (flag == "--max-error")
+	{
+		try_set_double_option(max_error_, parsed_option);
+	}
+	else if (flag == "--timbre-from-wav")
+	{
+		try_set_string_option(timbre_wav_file_, parsed_option);
+	}
+	else if (flag == "--fft-size")
+	{
+		try_set_size_option(fft_size_, parsed_option);
+	}
+	else if (flag == "--peak-threshold")
+	{
+		try_set_double_option(peak_settings_.threshold_db, parsed_option);
+	}
+	else if (flag == "--max-peaks")
+	{
+		try_set_size_option(peak_settings_.max_peaks, parsed_option);
+	}
+	else if (flag == "--shard")
+	{
+		try_set_shard(parsed_option);
+	}
+	else if (flag == "--checkpoint")
+	{
+		try_set_string_option(checkpoint_file_, parsed_option);
+	}
+	else if (flag == "--checkpoint-interval")
+	{
+		try_set_double_option(checkpoint_interval_, parsed_option);
+	}
+	else if (flag == "--decimate")
+	{
+		try_set_double_option(decimation_tolerance_, parsed_option);
+	}
+	else if (flag == "--progressive")
+	{
+		progressive_ = true;
+	}
+	else if (flag == "--mobile-timbres")
+	{
+		try_set_string_option(mobile_timbres_file_, parsed_option);
+	}
+	else if (flag == "--extra-file")
+	{
+		try_set_string_option(extra_file_, parsed_option);
+	}
+	else if (flag == "--chords")
+	{
+		try_set_string_option(chords_file_, parsed_option);
+	}
+	else if (flag == "--sweep")
+	{
+		try_set_sweep(parsed_option);
+	}
+	else if (flag == "--sweep-count")
+	{
+		try_set_size_option(sweep_count_, parsed_option);
+	}
+	else if (flag == "--frames")
+	{
+		try_set_string_option(frames_file_, parsed_option);
+	}
+	else if (flag == "--frame-summary")
+	{
+		try_set_string_option(frame_summary_name_, parsed_option);
+	}
+	else if (flag == "--frame-tolerance")
+	{
+		try_set_double_option(frame_tolerance_, parsed_option);
+	}
+	else if (flag == "--scale")
+	{
+		if (ensure_has_single_value(parsed_option))
+		{
+			scale_files_.push_back(parsed_option.values.front());
+		}
+	}
+	else if (flag == "--edo")
+	{
+		try_set_edo_range(parsed_option);
+	}
+	else if (flag == "--chord-size")
+	{
+		try_set_size_option(chord_size_, parsed_option);
+	}
+	else if (flag == "--optimize")
+	{
+		try_set_string_option(optimize_name_, parsed_option);
+	}
+	else if (flag == "--frequency-range")
+	{
+		try_set_double_option(frequency_range_, parsed_option);
+	}
+	else if (flag == "--amplitude-range")
+	{
+		try_set_double_option(amplitude_range_, parsed_option);
+	}
+	else if (flag == "--optimize-iterations")
+	{
+		try_set_size_option(optimize_iterations_, parsed_option);
+	}
+	else if (flag == "--threads" || flag == "-j")
+	{
+		try_set_size_option(thread_count_, parsed_option);
+	}
 	else if (flag == "-p")
 	{
 		stable_frequencies_.reserve(
@@ -160,10 +406,7 @@ void ProgramOptions::apply_option(ParsedOption const& parsed_option)
 	}
 	else if (flag == "-x")
 	{
-		try_insert_doubles(
-			std::inserter(extra_values_, std::end(extra_values_)),
-			parsed_option
-		);
+		try_insert_doubles(std::back_inserter(extra_values_), parsed_option);
 	}
 	else
 	{
@@ -174,6 +417,109 @@ void ProgramOptions::apply_option(ParsedOption const& parsed_option)
 	}
 }
 
+void ProgramOptions::try_set_edo_range(ParsedOption const& option)
+{
+	if (!ensure_has_single_value(option))
+	{
+		return;
+	}
+
+	std::string_view const arg = option.values.front();
+	auto const dash_pos = arg.find('-');
+
+	auto const first = parse_size(arg.substr(0, dash_pos));
+	auto const last = dash_pos == std::string_view::npos
+		? first
+		: parse_size(arg.substr(dash_pos + 1));
+	if (!first.has_value() || !last.has_value())
+	{
+		add_error(
+			arg,
+			CommandLineErrorType::invalid_number
+		);
+		return;
+	}
+
+	edo_range_ = EdoRange{*first, *last};
+}
+
+void ProgramOptions::try_set_shard(ParsedOption const& option)
+{
+	if (!ensure_has_single_value(option))
+	{
+		return;
+	}
+
+	std::string_view const arg = option.values.front();
+	auto const slash_pos = arg.find('/');
+	if (slash_pos == std::string_view::npos)
+	{
+		add_error(
+			"shard must have the form i/n",
+			CommandLineErrorType::generic
+		);
+		return;
+	}
+
+	auto const index = parse_size(arg.substr(0, slash_pos));
+	auto const count = parse_size(arg.substr(slash_pos + 1));
+	if (!index.has_value() || !count.has_value())
+	{
+		add_error(
+			arg,
+			CommandLineErrorType::invalid_number
+		);
+		return;
+	}
+
+	shard_ = ShardSelection{*index, *count};
+}
+
+void ProgramOptions::try_set_sweep(ParsedOption const& option)
+{
+	if (!ensure_has_single_value(option))
+	{
+		return;
+	}
+
+	std::string_view const arg = option.values.front();
+	auto const first_colon = arg.find(':');
+	auto const last_colon = arg.rfind(':');
+	if (first_colon == last_colon)
+	{
+		add_error(
+			"sweep must have the form parameter:first:last",
+			CommandLineErrorType::generic
+		);
+		return;
+	}
+
+	auto const parameter = find_timbre_parameter(arg.substr(0, first_colon));
+	if (!parameter.has_value())
+	{
+		add_error(
+			"sweep parameter must be stretch, rolloff or inharmonicity",
+			CommandLineErrorType::generic
+		);
+		return;
+	}
+
+	auto const first = parse_double(
+		arg.substr(first_colon + 1, last_colon - first_colon - 1)
+	);
+	auto const last = parse_double(arg.substr(last_colon + 1));
+	if (!first.has_value() || !last.has_value())
+	{
+		add_error(
+			arg,
+			CommandLineErrorType::invalid_number
+		);
+		return;
+	}
+
+	sweep_ = ParameterSweep{*parameter, *first, *last, 0};
+}
+
 bool ProgramOptions::ensure_has_single_value(ParsedOption const& option)
 {
 	if (option.values.empty())
@@ -202,10 +548,40 @@ void ProgramOptions::validate(void)
 		format_.has_value()
 		&& format_ != "csv"
 		&& format_ != "tsv"
+		&& format_ != "binary"
+		&& format_ != "cpp"
+		&& format_ != "chebyshev"
 	)
 	{
 		add_error(
-			"format must be csv or tsv",
+			"format must be csv, tsv, binary, cpp or chebyshev",
+			CommandLineErrorType::generic
+		);
+	}
+	if (
+		model_name_.has_value()
+		&& !find_dissonance_model(*model_name_).has_value()
+	)
+	{
+		add_error(
+			"model must be sethares, product or vassilakis",
+			CommandLineErrorType::generic
+		);
+	}
+	if (
+		engine_name_.has_value()
+		&& !find_engine(*engine_name_).has_value()
+	)
+	{
+		add_error(
+			"engine must be exact, fft or blocked",
+			CommandLineErrorType::generic
+		);
+	}
+	if (engine() == Engine::fft && model() == DissonanceModel::vassilakis)
+	{
+		add_error(
+			"fft engine cannot be used with the vassilakis model",
 			CommandLineErrorType::generic
 		);
 	}
@@ -231,6 +607,284 @@ void ProgramOptions::validate(void)
 		);
 	}
 
+	if (max_error_.has_value() && *max_error_ <= 0.0)
+	{
+		add_error(
+			"maximum error",
+			CommandLineErrorType::not_positive
+		);
+	}
+	if (!is_power_of_two(fft_size_) || fft_size_ < 16)
+	{
+		add_error(
+			"FFT size must be a power of two no less than 16",
+			CommandLineErrorType::generic
+		);
+	}
+	if (peak_settings_.threshold_db > 0.0)
+	{
+		add_error(
+			"peak threshold must not be greater than zero",
+			CommandLineErrorType::generic
+		);
+	}
+	if (shard_.has_value() && shard_->index >= shard_->count)
+	{
+		add_error(
+			"shard index must be less than the number of shards",
+			CommandLineErrorType::generic
+		);
+	}
+	if (checkpoint_file_.has_value() && !output_file_name_.has_value())
+	{
+		add_error(
+			"--checkpoint requires an output file",
+			CommandLineErrorType::generic
+		);
+	}
+	if (checkpoint_interval_ <= 0.0)
+	{
+		add_error(
+			"checkpoint interval",
+			CommandLineErrorType::not_positive
+		);
+	}
+	if (decimation_tolerance_.has_value() && *decimation_tolerance_ < 0.0)
+	{
+		add_error(
+			"decimation tolerance must not be negative",
+			CommandLineErrorType::generic
+		);
+	}
+	if (!is_valid_cpp_namespace(cpp_header_settings_.namespace_name))
+	{
+		add_error(
+			"C++ namespace must be identifiers separated by ::",
+			CommandLineErrorType::generic
+		);
+	}
+	if (curve_tolerance_ <= 0.0)
+	{
+		add_error(
+			"curve tolerance",
+			CommandLineErrorType::not_positive
+		);
+	}
+	if (curve_degree_ > max_chebyshev_degree)
+	{
+		add_error(
+			"curve degree must be at most 32",
+			CommandLineErrorType::generic
+		);
+	}
+	if (writes_chebyshev() && !(start_ < end_))
+	{
+		add_error(
+			"chebyshev format requires the start to be less than the end",
+			CommandLineErrorType::generic
+		);
+	}
+	if (writes_binary() && !sweep_.has_value())
+	{
+		add_error(
+			"binary format requires --sweep",
+			CommandLineErrorType::generic
+		);
+	}
+	if (
+		sweep_.has_value()
+		&& (
+			!is_valid_parameter_value(sweep_->parameter, sweep_->first)
+			|| !is_valid_parameter_value(sweep_->parameter, sweep_->last)
+		)
+	)
+	{
+		add_error(
+			"stretch must be positive and inharmonicity must not be negative",
+			CommandLineErrorType::generic
+		);
+	}
+	if (sweep_count_ == 0)
+	{
+		add_error(
+			"sweep count",
+			CommandLineErrorType::not_positive
+		);
+	}
+	if (
+		frame_summary_name_.has_value()
+		&& !find_frame_summary(*frame_summary_name_).has_value()
+	)
+	{
+		add_error(
+			"frame summary must be curve or minima",
+			CommandLineErrorType::generic
+		);
+	}
+	if (frame_tolerance_ < 0.0)
+	{
+		add_error(
+			"frame tolerance must not be negative",
+			CommandLineErrorType::generic
+		);
+	}
+	if (
+		edo_range_.has_value()
+		&& (edo_range_->first == 0 || edo_range_->first > edo_range_->last)
+	)
+	{
+		add_error(
+			"EDO range must be positive and in increasing order",
+			CommandLineErrorType::generic
+		);
+	}
+	if (chord_size_ < 2)
+	{
+		add_error(
+			"chord size must be at least 2",
+			CommandLineErrorType::generic
+		);
+	}
+	if (
+		optimize_name_.has_value()
+		&& !find_optimized_parameters(*optimize_name_).has_value()
+	)
+	{
+		add_error(
+			"optimized parameters must be frequencies, amplitudes or both",
+			CommandLineErrorType::generic
+		);
+	}
+	if (frequency_range_ < 0.0)
+	{
+		add_error(
+			"frequency range must not be negative",
+			CommandLineErrorType::generic
+		);
+	}
+	if (!(amplitude_range_ >= 1.0))
+	{
+		add_error(
+			"amplitude range must be at least 1",
+			CommandLineErrorType::generic
+		);
+	}
+	if (optimize_iterations_ == 0)
+	{
+		add_error(
+			"optimization iterations",
+			CommandLineErrorType::not_positive
+		);
+	}
+	bool const has_one_scale = edo_range_.has_value()
+		? scale_files_.empty() && edo_range_->first == edo_range_->last
+		: scale_files_.size() == 1;
+	if (optimize_name_.has_value() && !has_one_scale)
+	{
+		add_error(
+			"--optimize requires exactly one scale, given by --scale or --edo",
+			CommandLineErrorType::generic
+		);
+	}
+
+	// Only one mode can replace the plain table.
+	auto const modes = alternative_modes();
+	for (std::size_t i = 0; i < modes.size(); ++i)
+	{
+		add_conflict_error(modes[i], std::span(modes).subspan(i + 1));
+	}
+
+	auto const& frames = modes[1];
+	auto const& sweep = modes[2];
+	auto const& mobile_timbres = modes[4];
+	UsedOption const shard{"--shard", shard_.has_value()};
+	UsedOption const checkpoint{"--checkpoint", checkpoint_file_.has_value()};
+	UsedOption const decimate{"--decimate", decimation_tolerance_.has_value()};
+	UsedOption const progressive{"--progressive", progressive_};
+	UsedOption const other_engines{
+		"engines other than exact",
+		engine() != Engine::exact
+	};
+	UsedOption const cpp_format{"cpp format", writes_cpp()};
+	UsedOption const chebyshev_format{"chebyshev format", writes_chebyshev()};
+	UsedOption const other_formats{
+		"formats other than csv and tsv",
+		format_.has_value() && format_ != "csv" && format_ != "tsv"
+	};
+	UsedOption const max_error{"--max-error", max_error_.has_value()};
+
+	// These options only apply to plain tables of intervals.
+	if (!writes_plain_table())
+	{
+		for (auto const option : {
+			shard,
+			checkpoint,
+			decimate,
+			progressive,
+			other_engines,
+			cpp_format,
+			chebyshev_format
+		})
+		{
+			add_conflict_error(option, modes);
+		}
+	}
+
+	add_conflict_error(decimate, {checkpoint});
+	add_conflict_error(
+		progressive,
+		{shard, checkpoint, decimate, other_engines, other_formats}
+	);
+	add_conflict_error(
+		other_engines,
+		{shard, checkpoint, decimate, other_formats}
+	);
+	add_conflict_error(cpp_format, {shard, checkpoint});
+	add_conflict_error(
+		chebyshev_format,
+		{
+			{"-x", !extra_values_.empty()},
+			{"--extra-file", extra_file_.has_value()},
+			shard,
+			checkpoint,
+			decimate
+		}
+	);
+	add_conflict_error(
+		{"--timbre-from-wav", timbre_wav_file_.has_value()},
+		{
+			{"-p", !stable_frequencies_.empty()},
+			{"-a", !stable_amplitudes_.empty()}
+		}
+	);
+	add_conflict_error(
+		frames,
+		{
+			{"-p", !stable_frequencies_.empty()},
+			{"--timbre-from-wav", timbre_wav_file_.has_value()},
+			max_error
+		}
+	);
+	add_conflict_error(sweep, {max_error});
+	add_conflict_error(
+		mobile_timbres,
+		{
+			{"-P", has_mobile_partials()},
+			{"-A", !mobile_amplitudes_.empty()},
+			max_error
+		}
+	);
+	add_conflict_error(
+		{"--optimize", optimize_name_.has_value()},
+		{
+			{"-P", has_mobile_partials()},
+			{"-A", !mobile_amplitudes_.empty()},
+			max_error,
+			{"--chord-size", chord_size_ != 2},
+			{"--format", format_.has_value()}
+		}
+	);
+
 	auto const not_positive = [](double x) noexcept { return x <= 0.0; };
 	if (std::ranges::any_of(stable_frequencies_, not_positive))
 	{
@@ -305,6 +959,7 @@ ProgramOptions::ProgramOptions(int argc, char const* argv[])
 		return;
 	}
 
+	sort_extra_values(extra_values_);
 	validate();
 }
 } // namespace disscalc
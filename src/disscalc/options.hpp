@@ -2,13 +2,25 @@
 #define DISSCALC_OPTIONS_HPP_INCLUDED
 
 #include "disscalc/args-parsing.hpp"
+#include "disscalc/chebyshev-curve.hpp"
+#include "disscalc/code-generation.hpp"
 #include "disscalc/dissonance.hpp"
-
+#include "disscalc/engine.hpp"
+#include "disscalc/extra-values.hpp"
+#include "disscalc/frames.hpp"
+#include "disscalc/timbre-extraction.hpp"
+#include "disscalc/timbre-family.hpp"
+#include "disscalc/timbre-optimization.hpp"
+
+#include <array>
 #include <concepts>
+#include <cstddef>
 #include <iterator>
+#include <initializer_list>
 #include <optional>
-#include <set>
+#include <span>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 namespace disscalc
@@ -23,6 +35,8 @@ enum struct CommandLineErrorType
 	not_positive, ///< A single value is not positive and should be.
 	list_not_positive, ///< Not all in a list of values are positive.
 
+	conflicting, ///< Two options that cannot be used together.
+
 	generic, ///< Miscellaneous errors.
 };
 
@@ -32,12 +46,36 @@ struct CommandLineError
 	/// Text of the argument causing the error.
 	std::string_view argument_text;
 	CommandLineErrorType type;
+
+	/// Text of the option conflicting with the argument, if any.
+	std::string_view conflicting_text = {};
+};
+
+/// Inclusive range of equal divisions of the octave.
+struct EdoRange
+{
+	std::size_t first;
+	std::size_t last;
+};
+
+/// Selection of one of several equal parts of a table.
+struct ShardSelection
+{
+	std::size_t index;
+	std::size_t count;
 };
 
 // Try to parse `str` as a double, returning an empty optional on failure.
 [[nodiscard]]
 auto parse_double(std::string_view str) noexcept -> std::optional<double>;
 
+/*
+ * Try to parse `str` as a non-negative integer, returning an empty optional on
+ * failure.
+ */
+[[nodiscard]]
+auto parse_size(std::string_view str) noexcept -> std::optional<std::size_t>;
+
 /// Contains values of program options.
 class ProgramOptions
 {
@@ -102,19 +140,301 @@ public:
 	[[nodiscard]]
 	auto mobile_partials(void) const -> std::vector<Partial>;
 
+	/// Indicate whether mobile partials were given separately with `-P`.
+	[[nodiscard]]
+	bool has_mobile_partials(void) const noexcept
+	{
+		return !mobile_frequencies_.empty();
+	}
+
+	/// Bound on the error introduced by reducing partials, if requested.
 	[[nodiscard]]
-	auto extra_values(void) const noexcept -> std::set<double> const&
+	auto max_error(void) const noexcept -> std::optional<double>
+	{
+		return max_error_;
+	}
+
+	/// Get the WAV file from which to extract the stable timbre, if any.
+	[[nodiscard]]
+	auto timbre_wav_file(void) const noexcept
+		-> std::optional<std::string_view>
+	{
+		return timbre_wav_file_;
+	}
+
+	/// Size of each analysis frame used when extracting a timbre.
+	[[nodiscard]]
+	std::size_t fft_size(void) const noexcept
+	{
+		return fft_size_;
+	}
+
+	/// Settings for picking partials when extracting a timbre.
+	[[nodiscard]]
+	auto peak_settings(void) const noexcept -> PeakSettings const&
+	{
+		return peak_settings_;
+	}
+
+	/// Get the extra intervals to compute, in increasing order.
+	[[nodiscard]]
+	auto extra_values(void) const noexcept -> std::vector<double> const&
 	{
 		return extra_values_;
 	}
 
+	/// Get the file of extra intervals to compute, if any.
+	[[nodiscard]]
+	auto extra_file(void) const noexcept -> std::optional<std::string_view>
+	{
+		return extra_file_;
+	}
+
+	/** Add the extra intervals read from `extra_file`.
+	 *
+	 * `values` must be sorted without duplicates, as given by
+	 * `read_extra_values`.
+	 */
+	void add_extra_values(std::vector<double> values)
+	{
+		extra_values_ = merge_extra_values(
+			std::move(extra_values_),
+			std::move(values)
+		);
+	}
+
+	/// Get the part of the table to compute, if only one part is wanted.
+	[[nodiscard]]
+	auto shard(void) const noexcept -> std::optional<ShardSelection>
+	{
+		return shard_;
+	}
+
+	/// Get the file recording progress of the table, if any.
+	[[nodiscard]]
+	auto checkpoint_file(void) const noexcept
+		-> std::optional<std::string_view>
+	{
+		return checkpoint_file_;
+	}
+
+	/// Least number of seconds between saving checkpoints.
+	[[nodiscard]]
+	double checkpoint_interval(void) const noexcept
+	{
+		return checkpoint_interval_;
+	}
+
+	/// Tolerance for dropping rows from the table, if decimation is wanted.
+	[[nodiscard]]
+	auto decimation_tolerance(void) const noexcept -> std::optional<double>
+	{
+		return decimation_tolerance_;
+	}
+
+	/// Indicate whether the table is output coarsely first, then refined.
+	[[nodiscard]]
+	bool is_progressive(void) const noexcept
+	{
+		return progressive_;
+	}
+
+	/** Get the file of timbre frames to analyze, if any.
+	 *
+	 * A file name of "-" means standard input.
+	 */
+	[[nodiscard]]
+	auto frames_file(void) const noexcept -> std::optional<std::string_view>
+	{
+		return frames_file_;
+	}
+
+	/// Get what is output for each timbre frame.
+	[[nodiscard]]
+	FrameSummary frame_summary(void) const noexcept;
+
+	/// Relative difference below which frames reuse the previous curve.
+	[[nodiscard]]
+	double frame_tolerance(void) const noexcept
+	{
+		return frame_tolerance_;
+	}
+
+	/// Get the parameter sweep given with `--sweep`, if any.
+	[[nodiscard]]
+	auto sweep(void) const noexcept -> std::optional<ParameterSweep>
+	{
+		if (!sweep_.has_value())
+		{
+			return std::nullopt;
+		}
+		auto sweep = *sweep_;
+		sweep.count = sweep_count_;
+		return sweep;
+	}
+
+	/** Get the file of mobile timbres to compare, if any.
+	 *
+	 * Each line holds a timbre in the same format as `frames_file`.
+	 */
+	[[nodiscard]]
+	auto mobile_timbres_file(void) const noexcept
+		-> std::optional<std::string_view>
+	{
+		return mobile_timbres_file_;
+	}
+
+	/// Get the file of chords to evaluate, if any.
+	[[nodiscard]]
+	auto chords_file(void) const noexcept -> std::optional<std::string_view>
+	{
+		return chords_file_;
+	}
+
+	/// Get the Scala files given with `--scale`, in order.
+	[[nodiscard]]
+	auto scale_files(void) const noexcept
+		-> std::vector<std::string_view> const&
+	{
+		return scale_files_;
+	}
+
+	/// Get the range of equal divisions of the octave to evaluate, if any.
+	[[nodiscard]]
+	auto edo_range(void) const noexcept -> std::optional<EdoRange>
+	{
+		return edo_range_;
+	}
+
+	/// Indicate whether scales are evaluated instead of a dissonance curve.
+	[[nodiscard]]
+	bool evaluates_scales(void) const noexcept
+	{
+		return !scale_files_.empty() || edo_range_.has_value();
+	}
+
+	/// Largest chord size evaluated in each scale.
+	[[nodiscard]]
+	std::size_t chord_size(void) const noexcept
+	{
+		return chord_size_;
+	}
+
+	/// Indicate whether the timbre is optimized to fit the scale.
+	[[nodiscard]]
+	bool optimizes_timbre(void) const noexcept
+	{
+		return optimize_name_.has_value();
+	}
+
+	/// Get the parameters and bounds used when optimizing the timbre.
+	[[nodiscard]]
+	auto optimization_settings(void) const noexcept
+		-> TimbreOptimizationSettings;
+
+	/// Requested number of worker threads, where zero means automatic.
+	[[nodiscard]]
+	std::size_t thread_count(void) const noexcept
+	{
+		return thread_count_;
+	}
+
+	/// Get the dissonance model to use.
+	[[nodiscard]]
+	DissonanceModel model(void) const noexcept;
+
+	/// Get the engine computing the rows of a curve.
+	[[nodiscard]]
+	Engine engine(void) const noexcept;
+
+	/// Indicate whether output is binary rather than delimiter separated.
+	[[nodiscard]]
+	bool writes_binary(void) const noexcept
+	{
+		return format_ == "binary";
+	}
+
+	/// Indicate whether output is a C++ header.
+	[[nodiscard]]
+	bool writes_cpp(void) const noexcept
+	{
+		return format_ == "cpp";
+	}
+
+	/// Get the settings of C++ header output.
+	[[nodiscard]]
+	auto cpp_header_settings(void) const noexcept -> CppHeaderSettings
+	{
+		return cpp_header_settings_;
+	}
+
+	/// Indicate whether output is a piecewise Chebyshev curve.
+	[[nodiscard]]
+	bool writes_chebyshev(void) const noexcept
+	{
+		return format_ == "chebyshev";
+	}
+
+	/// Largest error allowed when fitting a Chebyshev curve.
+	[[nodiscard]]
+	double curve_tolerance(void) const noexcept
+	{
+		return curve_tolerance_;
+	}
+
+	/// Degree of the series on each segment of a Chebyshev curve.
+	[[nodiscard]]
+	std::size_t curve_degree(void) const noexcept
+	{
+		return curve_degree_;
+	}
+
 	/// Get delimiter for DSV table output.
 	[[nodiscard]]
 	char delimiter(void) const noexcept;
 
 private:
+	// An option that may conflict with others, and whether it was given.
+	struct UsedOption
+	{
+		std::string_view name;
+		bool is_used;
+	};
+
 	// Add an error to the error list and mark these options as invalid.
-	void add_error(std::string_view text, CommandLineErrorType type);
+	void add_error(
+		std::string_view text,
+		CommandLineErrorType type,
+		std::string_view conflicting_text = {}
+	);
+
+	/*
+	 * If `option` is used, add an error naming the first of `others` that is
+	 * also used.
+	 */
+	void add_conflict_error(
+		UsedOption option,
+		std::span<UsedOption const> others
+	);
+
+	void add_conflict_error(
+		UsedOption option,
+		std::initializer_list<UsedOption> others
+	)
+	{
+		add_conflict_error(option, {others.begin(), others.size()});
+	}
+
+	/*
+	 * Modes which replace the plain table of intervals with some other
+	 * output, and which cannot be used together.
+	 */
+	[[nodiscard]]
+	auto alternative_modes(void) const noexcept -> std::array<UsedOption, 5>;
+
+	// Indicate whether the output is a plain table of intervals.
+	[[nodiscard]]
+	bool writes_plain_table(void) const noexcept;
 
 	/*
 	 * Try to apply the given option, adding any errors and setting
@@ -173,6 +493,52 @@ private:
 		);
 	}
 
+	/*
+	 * Try to set `to_set` to the value of a non-negative integer option
+	 * with a single value, reporting errors if there is not exactly one
+	 * value or if it is not a valid integer.
+	 */
+	void try_set_size_option(
+		std::assignable_from<std::size_t> auto&& to_set,
+		ParsedOption const& option
+	)
+	{
+		if (!ensure_has_single_value(option))
+		{
+			return;
+		}
+
+		std::string_view const arg = option.values.front();
+		if (auto value = parse_size(arg))
+		{
+			to_set = *value;
+			return;
+		}
+
+		add_error(
+			arg,
+			CommandLineErrorType::invalid_number
+		);
+	}
+
+	/*
+	 * Try to set `edo_range_` from an option whose value is either a
+	 * single number of divisions or a range such as "5-200".
+	 */
+	void try_set_edo_range(ParsedOption const& option);
+
+	/*
+	 * Try to set `shard_` from an option whose value has the form "i/n",
+	 * selecting the `i`th of `n` parts counting from zero.
+	 */
+	void try_set_shard(ParsedOption const& option);
+
+	/*
+	 * Try to set the parameter and range of the sweep from an option of the
+	 * form "parameter:first:last". On failure, add an error.
+	 */
+	void try_set_sweep(ParsedOption const& option);
+
 	/*
 	 * For each value in `option`, try to parse it as a double and insert
 	 * it using the output iterator `dest`, reporting relevant errors.
@@ -209,6 +575,8 @@ private:
 
 	std::optional<std::string_view> output_file_name_;
 	std::optional<std::string_view> format_;
+	std::optional<std::string_view> model_name_;
+	std::optional<std::string_view> engine_name_;
 
 	double start_ = 1.0;
 	double delta_ = 0.01;
@@ -220,7 +588,46 @@ private:
 	std::vector<double> mobile_frequencies_;
 	std::vector<double> mobile_amplitudes_;
 
-	std::set<double> extra_values_;
+	std::vector<double> extra_values_;
+	std::optional<std::string_view> extra_file_;
+
+	std::optional<double> max_error_;
+
+	std::optional<std::string_view> timbre_wav_file_;
+	std::size_t fft_size_ = 8192;
+	PeakSettings peak_settings_;
+
+	std::optional<ShardSelection> shard_;
+	std::optional<std::string_view> checkpoint_file_;
+	double checkpoint_interval_ = 10.0;
+
+	std::optional<double> decimation_tolerance_;
+	bool progressive_ = false;
+
+	CppHeaderSettings cpp_header_settings_;
+
+	double curve_tolerance_ = 1e-6;
+	std::size_t curve_degree_ = 16;
+
+	std::optional<std::string_view> chords_file_;
+	std::optional<std::string_view> mobile_timbres_file_;
+
+	std::optional<ParameterSweep> sweep_;
+	std::size_t sweep_count_ = 11;
+
+	std::optional<std::string_view> frames_file_;
+	std::optional<std::string_view> frame_summary_name_;
+	double frame_tolerance_ = 0.0;
+
+	std::vector<std::string_view> scale_files_;
+	std::optional<EdoRange> edo_range_;
+	std::size_t chord_size_ = 2;
+
+	std::optional<std::string_view> optimize_name_;
+	double frequency_range_ = 50.0;
+	double amplitude_range_ = 2.0;
+	std::size_t optimize_iterations_ = 100;
+	std::size_t thread_count_ = 0;
 	
 	std::vector<CommandLineError> errors_;
 };
@@ -1,5 +1,7 @@
 #include "disscalc/output.hpp"
 
+#include "disscalc/binary-io.hpp"
+
 #include <generated/usage.hpp>
 
 #include <iomanip>
@@ -45,6 +47,11 @@ void print_command_line_error(std::ostream& out, CommandLineError error)
 		out << error.argument_text << " must all be greater than zero";
 		break;
 
+	case CommandLineErrorType::conflicting:
+		out << error.argument_text << " cannot be used with "
+			<< error.conflicting_text;
+		break;
+
 	case CommandLineErrorType::generic:
 		out << error.argument_text;
 		break;
@@ -61,6 +68,154 @@ void print_generic_error(std::ostream& out, std::string_view error)
 	out << get_error_header() << error << '\n';
 }
 
+void print_reduction_report(std::ostream& out, ReductionReport const& report)
+{
+	out << "Disscalc: removed "
+		<< report.stable_before - report.stable_after << " of "
+		<< report.stable_before << " stable partials and "
+		<< report.mobile_before - report.mobile_after << " of "
+		<< report.mobile_before << " mobile partials (error bound "
+		<< report.error_bound << ", amplitude floor "
+		<< report.amplitude_floor << ", merge tolerance "
+		<< report.merge_tolerance << ")\n";
+}
+
+void print_engine_error(std::ostream& out, EngineError const& error)
+{
+	if (error.sample_count == 0)
+	{
+		out << "Disscalc: engine error not measured, since the table is "
+			"empty\n";
+		return;
+	}
+	if (error.sampled_partials > 0)
+	{
+		out << "Disscalc: engine error estimated from "
+			<< error.sampled_partials << " random stable partials at "
+			<< error.sample_count << " intervals: relative "
+			<< error.max_relative << '\n';
+		return;
+	}
+	out << "Disscalc: engine error at " << error.sample_count
+		<< " intervals: max absolute " << error.max_absolute
+		<< ", relative " << error.max_relative << '\n';
+}
+
+void print_optimization_report(
+	std::ostream& out,
+	TimbreOptimization const& optimization
+)
+{
+	out << "Disscalc: lowered the total dissonance of the scale from "
+		<< optimization.initial_dissonance << " to "
+		<< optimization.final_dissonance << " in "
+		<< optimization.iterations << " iterations\n";
+}
+
+void print_timbre_options(std::ostream& out, std::span<Partial const> partials)
+{
+	// Enough digits that small adjustments to frequencies are kept.
+	constexpr std::streamsize timbre_precision = 10;
+	auto const precision = out.precision(timbre_precision);
+
+	out << "-p";
+	for (auto const partial : partials)
+	{
+		out << ' ' << partial.frequency;
+	}
+	out << " -a";
+	for (auto const partial : partials)
+	{
+		out << ' ' << partial.amplitude;
+	}
+	out << '\n';
+
+	out.precision(precision);
+}
+
+void print_scale_evaluation(
+	std::ostream& out,
+	Scale const& scale,
+	ScaleEvaluation const& evaluation,
+	char delimiter
+)
+{
+	out << scale.name
+		<< delimiter << scale.steps()
+		<< delimiter << evaluation.total
+		<< delimiter << evaluation.per_step;
+	for (auto const chord_dissonance : evaluation.least_chord_dissonances)
+	{
+		out << delimiter << chord_dissonance;
+	}
+	out << '\n';
+}
+
+void print_chord_dissonance(
+	std::ostream& out,
+	Chord const& chord,
+	double dissonance,
+	char delimiter
+)
+{
+	out << chord.name << delimiter << dissonance << '\n';
+}
+
+void print_frame_rows(
+	std::ostream& out,
+	std::size_t frame_index,
+	std::span<TableRow const> rows,
+	char delimiter
+)
+{
+	for (auto const& row : rows)
+	{
+		out << frame_index << delimiter;
+		print_table_entry(out, row.input, row.output, delimiter);
+	}
+}
+
+void print_matrix_as_dsv(
+	std::ostream& out,
+	DissonanceMatrix const& matrix,
+	char delimiter
+)
+{
+	for (auto const interval : matrix.intervals)
+	{
+		out << delimiter << interval;
+	}
+	out << '\n';
+
+	for (std::size_t row = 0; row < matrix.parameters.size(); ++row)
+	{
+		out << matrix.parameters[row];
+		for (std::size_t column = 0; column < matrix.intervals.size(); ++column)
+		{
+			out << delimiter << matrix.at(row, column);
+		}
+		out << '\n';
+	}
+}
+
+void write_matrix_as_binary(std::ostream& out, DissonanceMatrix const& matrix)
+{
+	write_little_endian(out, matrix.parameters.size());
+	write_little_endian(out, matrix.intervals.size());
+
+	for (auto const& numbers : {
+		std::span(matrix.intervals),
+		std::span(matrix.parameters),
+		std::span(matrix.values)
+	})
+	{
+		for (auto const x : numbers)
+		{
+			write_little_endian_double(out, x);
+		}
+	}
+}
+
 void print_usage_message(std::ostream& out)
 {
 	out << usage_message;
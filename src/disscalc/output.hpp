@@ -2,7 +2,14 @@
 #define DISSCALC_OUTPUT_HPP_INCLUDED
 
 #include "disscalc/options.hpp"
+#include "disscalc/chords.hpp"
 #include "disscalc/dissonance.hpp"
+#include "disscalc/engine.hpp"
+#include "disscalc/reduction.hpp"
+#include "disscalc/scales.hpp"
+#include "disscalc/table.hpp"
+#include "disscalc/timbre-family.hpp"
+#include "disscalc/timbre-optimization.hpp"
 
 #include <iostream>
 #include <span>
@@ -16,6 +23,76 @@ void print_command_line_error(std::ostream& out, CommandLineError error);
 /// Print a generic error.
 void print_generic_error(std::ostream& out, std::string_view error);
 
+/// Print how many partials were removed by a reduction.
+void print_reduction_report(std::ostream& out, ReductionReport const& report);
+
+/// Print the error of an approximate engine, or that it was not measured.
+void print_engine_error(std::ostream& out, EngineError const& error);
+
+/// Print how much optimizing a timbre lowered its dissonance.
+void print_optimization_report(
+	std::ostream& out,
+	TimbreOptimization const& optimization
+);
+
+/** Print a timbre as the options giving it.
+ *
+ * The timbre is printed on one line as "-p", the frequencies, "-a" and the
+ * amplitudes, so it can be passed back to disscalc.
+ */
+void print_timbre_options(std::ostream& out, std::span<Partial const> partials);
+
+/** Print a single row summarizing the evaluation of a scale.
+ *
+ * The row holds the name of the scale, its number of steps, its total and
+ * per-step dissonance and then the least dissonant chord of each size.
+ */
+void print_scale_evaluation(
+	std::ostream& out,
+	Scale const& scale,
+	ScaleEvaluation const& evaluation,
+	char delimiter
+);
+
+/// Print a row holding a chord as it was written and its dissonance.
+void print_chord_dissonance(
+	std::ostream& out,
+	Chord const& chord,
+	double dissonance,
+	char delimiter
+);
+
+/** Print rows of the curve of a single timbre frame.
+ *
+ * Each row holds the index of the frame, the interval and the dissonance.
+ */
+void print_frame_rows(
+	std::ostream& out,
+	std::size_t frame_index,
+	std::span<TableRow const> rows,
+	char delimiter
+);
+
+/** Print a dissonance matrix as delimiter separated values.
+ *
+ * The first row holds the interval of each column after an empty cell, and
+ * each following row holds the value of the parameter and then the dissonances.
+ */
+void print_matrix_as_dsv(
+	std::ostream& out,
+	DissonanceMatrix const& matrix,
+	char delimiter
+);
+
+/** Write a dissonance matrix in binary.
+ *
+ * Every number is little-endian. The number of rows and the number of columns
+ * come first as 64-bit unsigned integers, followed by the interval of each
+ * column, the parameter of each row and finally the dissonances row by row,
+ * all as 64-bit IEEE 754 floating point numbers.
+ */
+void write_matrix_as_binary(std::ostream& out, DissonanceMatrix const& matrix);
+
 /// Print the usage message to `out`.
 void print_usage_message(std::ostream& out);
 } // namespace disscalc
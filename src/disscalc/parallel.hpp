@@ -0,0 +1,83 @@
+#ifndef DISSCALC_PARALLEL_HPP_INCLUDED
+#define DISSCALC_PARALLEL_HPP_INCLUDED
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace disscalc
+{
+/** Get the number of worker threads to use for a requested thread count.
+ *
+ * A request of zero means "use the hardware concurrency". The result is
+ * always at least one.
+ */
+[[nodiscard]] inline
+std::size_t resolve_thread_count(std::size_t requested) noexcept
+{
+	if (requested != 0)
+	{
+		return requested;
+	}
+	return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+}
+
+/** Call `func(i)` for each `i` in `[0, count)` using several threads.
+ *
+ * Indices are handed out one at a time, so uneven amounts of work per index
+ * are balanced between threads. The calling thread also does work, and this
+ * only returns once every call has finished. `func` must be safe to call
+ * concurrently with different indices.
+ *
+ * @param count the number of indices.
+ *
+ * @param thread_count the maximum number of threads to use, with zero meaning
+ * the hardware concurrency.
+ *
+ * @param func the function called for each index.
+ */
+void parallel_for(
+	std::size_t count,
+	std::size_t thread_count,
+	std::invocable<std::size_t> auto func
+)
+{
+	thread_count = std::min(resolve_thread_count(thread_count), count);
+
+	std::atomic<std::size_t> next_index = 0;
+	auto const work = [&]()
+		noexcept(std::is_nothrow_invocable_v<decltype(func)&, std::size_t>)
+	{
+		for (
+			std::size_t i = next_index.fetch_add(1, std::memory_order_relaxed);
+			i < count;
+			i = next_index.fetch_add(1, std::memory_order_relaxed)
+		)
+		{
+			std::invoke(func, i);
+		}
+	};
+
+	if (thread_count <= 1)
+	{
+		work();
+		return;
+	}
+
+	// Joined automatically on destruction.
+	std::vector<std::jthread> helpers;
+	helpers.reserve(thread_count - 1);
+	for (std::size_t t = 1; t < thread_count; ++t)
+	{
+		helpers.emplace_back(work);
+	}
+	work();
+}
+} // namespace disscalc
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef DISSCALC_PARTIAL_HPP_INCLUDED
+#define DISSCALC_PARTIAL_HPP_INCLUDED
+
+namespace disscalc
+{
+/// Data associated with a partial; that is, its frequency and amplitude.
+struct Partial
+{
+	double frequency;
+	double amplitude;
+};
+} // namespace disscalc
+
+#endif
@@ -0,0 +1,585 @@
+#include "disscalc/reduction.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <optional>
+#include <span>
+
+namespace disscalc
+{
+/*
+ * Upper bounds on the unweighted dissonance of a pair of partials, and on how
+ * quickly it changes with the frequency of either partial, given a lower bound
+ * on the scaled distance `x` between them.
+ *
+ * The curve is sampled densely, and the bounds are running maxima from the
+ * tail of the curve inward, with a margin for the sampling.
+ */
+template <DissonanceModelPolicy Model>
+class CurveEnvelopes
+{
+public:
+	CurveEnvelopes(void)
+		: magnitudes_(sample_count),
+		slopes_(sample_count)
+	{
+		/*
+		 * x = dstar * |f_b - f_a| / (s1 * min(f_a, f_b) + s2). Moving the
+		 * higher partial changes x at a rate of at most dstar / s2, and
+		 * moving the lower partial also shrinks the denominator, adding
+		 * a factor of (1 + x * s1 / dstar).
+		 */
+		constexpr double greatest_rate = Model::dstar / Model::s2;
+		constexpr double denominator_rate = Model::s1 / Model::dstar;
+
+		double greatest_magnitude = 0.0;
+		double greatest_slope = 0.0;
+		for (std::size_t i = sample_count; i-- > 0;)
+		{
+			double const x = static_cast<double>(i) * sample_step;
+			greatest_magnitude = std::max(
+				greatest_magnitude,
+				std::abs(roughness_curve<Model>(x))
+			);
+			greatest_slope = std::max(
+				greatest_slope,
+				std::abs(roughness_curve_slope<Model>(x))
+					* greatest_rate
+					* (1.0 + x * denominator_rate)
+			);
+			magnitudes_[i] = greatest_magnitude * sampling_margin;
+			slopes_[i] = greatest_slope * sampling_margin;
+		}
+	}
+
+	// Bound on the unweighted dissonance where x is at least `least_x`.
+	[[nodiscard]]
+	double magnitude(double least_x) const noexcept
+	{
+		return lookup(magnitudes_, least_x);
+	}
+
+	/*
+	 * Bound on the rate of change of the unweighted dissonance with respect
+	 * to the frequency of either partial where x is at least `least_x`.
+	 */
+	[[nodiscard]]
+	double slope(double least_x) const noexcept
+	{
+		return lookup(slopes_, least_x);
+	}
+
+private:
+	static constexpr double sample_step = 1.0 / 1024.0;
+
+	// Beyond this, both exponentials are cut off for every model.
+	static constexpr std::size_t sample_count = 64 * 1024;
+
+	static constexpr double sampling_margin = 1.01;
+
+	[[nodiscard]] static
+	double lookup(std::vector<double> const& table, double least_x) noexcept
+	{
+		auto const index = static_cast<std::size_t>(least_x / sample_step);
+		return index < table.size() ? table[index] : 0.0;
+	}
+
+	std::vector<double> magnitudes_;
+	std::vector<double> slopes_;
+};
+
+/*
+ * Partials on one side of an interval along with the range of factors by which
+ * their frequencies are scaled. Stable partials have a factor of 1.
+ */
+struct ScaledPartials
+{
+	std::span<Partial const> partials;
+	double least_scale;
+	double greatest_scale;
+};
+
+/*
+ * One side being reduced against the other, along with the scale factors of
+ * the side being reduced. A shared timbre plays both roles.
+ */
+struct ReductionRole
+{
+	double least_scale;
+	double greatest_scale;
+	ScaledPartials other;
+};
+
+/*
+ * Removal of a single partial, either by dropping it when `first == last` or
+ * by replacing the adjacent partials `first` and `last` with `merged`.
+ */
+struct ReductionCandidate
+{
+	std::size_t first;
+	std::size_t last;
+	Partial merged;
+
+	// Bound for each role, summed.
+	double bound;
+
+	// Bound for the first role alone.
+	double first_role_bound;
+};
+
+/*
+ * Find the least possible scaled distance between a partial whose frequency
+ * lies in `[least_freq, greatest_freq]` and `other`, over every scale factor.
+ */
+template <DissonanceModelPolicy Model>
+[[nodiscard]] static
+double least_scaled_distance(
+	double least_freq,
+	double greatest_freq,
+	ReductionRole const& role,
+	Partial other
+) noexcept
+{
+	double const low = least_freq * role.least_scale;
+	double const high = greatest_freq * role.greatest_scale;
+	double const other_low = other.frequency * role.other.least_scale;
+	double const other_high = other.frequency * role.other.greatest_scale;
+
+	double const gap = std::max({0.0, low - other_high, other_low - high});
+	double const greatest_least_freq = std::min(high, other_high);
+	return Model::dstar * gap / (Model::s1 * greatest_least_freq + Model::s2);
+}
+
+// Bound the change in dissonance caused by dropping `dropped`.
+template <DissonanceModelPolicy Model>
+[[nodiscard]] static
+double drop_bound(
+	Partial dropped,
+	ReductionRole const& role,
+	CurveEnvelopes<Model> const& envelopes
+) noexcept
+{
+	double bound = 0.0;
+	for (auto const other : role.other.partials)
+	{
+		double const least_x = least_scaled_distance<Model>(
+			dropped.frequency,
+			dropped.frequency,
+			role,
+			other
+		);
+		bound += Model::weight(dropped.amplitude, other.amplitude)
+			* envelopes.magnitude(least_x);
+	}
+	return bound;
+}
+
+/*
+ * Bound the change in dissonance caused by replacing `a` and `b` with
+ * `merged`, whose frequency lies between them.
+ *
+ * For each other partial, the change is
+ *
+ *     (w_m - w_a - w_b) * g(x_m) + w_a * (g(x_m) - g(x_a))
+ *         + w_b * (g(x_m) - g(x_b))
+ *
+ * where each difference of `g` is bounded by the distance moved times the
+ * greatest slope along the way.
+ */
+template <DissonanceModelPolicy Model>
+[[nodiscard]] static
+double merge_bound(
+	Partial a,
+	Partial b,
+	Partial merged,
+	ReductionRole const& role,
+	CurveEnvelopes<Model> const& envelopes
+) noexcept
+{
+	double const least_freq = std::min(a.frequency, b.frequency);
+	double const greatest_freq = std::max(a.frequency, b.frequency);
+	double const moved = role.greatest_scale
+		* (std::abs(merged.frequency - a.frequency)
+			+ std::abs(merged.frequency - b.frequency));
+
+	double bound = 0.0;
+	for (auto const other : role.other.partials)
+	{
+		double const least_x = least_scaled_distance<Model>(
+			least_freq,
+			greatest_freq,
+			role,
+			other
+		);
+		double const weight_a = Model::weight(a.amplitude, other.amplitude);
+		double const weight_b = Model::weight(b.amplitude, other.amplitude);
+		double const weight_merged =
+			Model::weight(merged.amplitude, other.amplitude);
+
+		bound += std::abs(weight_merged - weight_a - weight_b)
+				* envelopes.magnitude(least_x)
+			+ std::max(weight_a, weight_b) * moved
+				* envelopes.slope(least_x);
+	}
+	return bound;
+}
+
+// Find the bound of `candidate` for a single role.
+template <DissonanceModelPolicy Model>
+[[nodiscard]] static
+double candidate_bound(
+	std::span<Partial const> partials,
+	ReductionCandidate const& candidate,
+	ReductionRole const& role,
+	CurveEnvelopes<Model> const& envelopes
+) noexcept
+{
+	if (candidate.first == candidate.last)
+	{
+		return drop_bound(partials[candidate.first], role, envelopes);
+	}
+	return merge_bound(
+		partials[candidate.first],
+		partials[candidate.last],
+		candidate.merged,
+		role,
+		envelopes
+	);
+}
+
+/*
+ * Choose which partials of `partials`, sorted by frequency, to drop or merge
+ * while the sum of the bounds for every role stays within `budget`.
+ */
+template <DissonanceModelPolicy Model>
+[[nodiscard]] static
+auto plan_reduction(
+	std::span<Partial const> partials,
+	std::span<ReductionRole const> roles,
+	CurveEnvelopes<Model> const& envelopes,
+	double budget
+) -> std::vector<ReductionCandidate>
+{
+	auto const with_bounds = [&](ReductionCandidate candidate)
+	{
+		candidate.bound = 0.0;
+		for (auto const& role : roles)
+		{
+			double const bound =
+				candidate_bound(partials, candidate, role, envelopes);
+			candidate.bound += bound;
+			if (&role == &roles.front())
+			{
+				candidate.first_role_bound = bound;
+			}
+		}
+		return candidate;
+	};
+
+	std::vector<ReductionCandidate> candidates;
+	candidates.reserve(2 * partials.size());
+	for (std::size_t i = 0; i < partials.size(); ++i)
+	{
+		candidates.push_back(with_bounds({i, i, partials[i], 0.0, 0.0}));
+
+		if (i + 1 == partials.size())
+		{
+			continue;
+		}
+
+		// Merge at the amplitude-weighted mean frequency.
+		auto const a = partials[i];
+		auto const b = partials[i + 1];
+		double const total_amp = a.amplitude + b.amplitude;
+		double const mean_freq =
+			(a.frequency * a.amplitude + b.frequency * b.amplitude)
+			/ total_amp;
+
+		// Keep whichever merged amplitude disturbs the curve least.
+		auto const summed = with_bounds(
+			{i, i + 1, {mean_freq, total_amp}, 0.0, 0.0}
+		);
+		auto const loudest = with_bounds({
+			i,
+			i + 1,
+			{mean_freq, std::max(a.amplitude, b.amplitude)},
+			0.0,
+			0.0
+		});
+		candidates.push_back(
+			summed.bound <= loudest.bound ? summed : loudest
+		);
+	}
+
+	std::ranges::stable_sort(candidates, {}, &ReductionCandidate::bound);
+
+	std::vector<bool> used(partials.size(), false);
+	std::vector<ReductionCandidate> chosen;
+	double total_bound = 0.0;
+	for (auto const& candidate : candidates)
+	{
+		if (total_bound + candidate.bound > budget)
+		{
+			break;
+		}
+		if (used[candidate.first] || used[candidate.last])
+		{
+			continue;
+		}
+
+		used[candidate.first] = true;
+		used[candidate.last] = true;
+		total_bound += candidate.bound;
+		chosen.push_back(candidate);
+	}
+
+	return chosen;
+}
+
+// Apply the chosen removals to `partials`.
+[[nodiscard]] static
+auto apply_reduction(
+	std::span<Partial const> partials,
+	std::span<ReductionCandidate const> chosen
+) -> std::vector<Partial>
+{
+	std::vector<std::optional<Partial>> replaced(
+		std::begin(partials),
+		std::end(partials)
+	);
+	for (auto const& candidate : chosen)
+	{
+		replaced[candidate.first].reset();
+		replaced[candidate.last].reset();
+		if (candidate.first != candidate.last)
+		{
+			replaced[candidate.first] = candidate.merged;
+		}
+	}
+
+	std::vector<Partial> result;
+	result.reserve(partials.size() - chosen.size());
+	for (auto const& partial : replaced)
+	{
+		if (partial.has_value())
+		{
+			result.push_back(*partial);
+		}
+	}
+	return result;
+}
+
+// Record the amplitude floor and merge tolerance of the chosen removals.
+static
+void add_to_report(
+	ReductionReport& report,
+	std::span<Partial const> partials,
+	std::span<ReductionCandidate const> chosen
+) noexcept
+{
+	for (auto const& candidate : chosen)
+	{
+		auto const first = partials[candidate.first];
+		auto const last = partials[candidate.last];
+		if (candidate.first == candidate.last)
+		{
+			report.amplitude_floor =
+				std::max(report.amplitude_floor, first.amplitude);
+		}
+		else
+		{
+			report.merge_tolerance = std::max(
+				report.merge_tolerance,
+				last.frequency - first.frequency
+			);
+		}
+	}
+}
+
+// Sort partials by frequency, so that neighbours can be merged.
+static
+void sort_by_frequency(std::vector<Partial>& partials)
+{
+	std::ranges::stable_sort(partials, {}, &Partial::frequency);
+}
+
+template <DissonanceModelPolicy Model>
+[[nodiscard]] static
+auto reduce_shared_partials(
+	std::vector<Partial>& partials,
+	IntervalBounds intervals,
+	double max_error,
+	CurveEnvelopes<Model> const& envelopes,
+	ReductionReport& report
+) -> double
+{
+	/*
+	 * D(S, S) - D(S', S') = [D(S, S) - D(S', S)] + [D(S', S) - D(S', S')],
+	 * so the stable role is bounded against the original timbre and the
+	 * mobile role against the reduced one. The plan only estimates the
+	 * latter, so the budget shrinks until the real bound fits.
+	 */
+	for (double budget = max_error; budget > max_error * 1e-6; budget /= 2)
+	{
+		std::array const roles = {
+			ReductionRole{
+				1.0,
+				1.0,
+				{partials, intervals.least, intervals.greatest}
+			},
+			ReductionRole{
+				intervals.least,
+				intervals.greatest,
+				{partials, 1.0, 1.0}
+			},
+		};
+		auto const chosen =
+			plan_reduction<Model>(partials, roles, envelopes, budget);
+
+		auto reduced = apply_reduction(partials, chosen);
+		ReductionRole const mobile_role{
+			intervals.least,
+			intervals.greatest,
+			{reduced, 1.0, 1.0}
+		};
+
+		double bound = 0.0;
+		for (auto const& candidate : chosen)
+		{
+			bound += candidate.first_role_bound
+				+ candidate_bound<Model>(
+					partials,
+					candidate,
+					mobile_role,
+					envelopes
+				);
+		}
+
+		if (bound <= max_error)
+		{
+			add_to_report(report, partials, chosen);
+			partials = std::move(reduced);
+			return bound;
+		}
+	}
+
+	return 0.0;
+}
+
+template <DissonanceModelPolicy Model>
+[[nodiscard]]
+auto reduce_partials(
+	std::vector<Partial>& stable,
+	std::vector<Partial>& mobile,
+	bool shared,
+	IntervalBounds intervals,
+	double max_error
+) -> ReductionReport
+{
+	assert(intervals.least > 0.0 && intervals.least <= intervals.greatest);
+
+	CurveEnvelopes<Model> const envelopes;
+	ReductionReport report{
+		stable.size(),
+		0,
+		shared ? stable.size() : mobile.size(),
+		0,
+		0.0,
+		0.0,
+		0.0
+	};
+
+	sort_by_frequency(stable);
+	if (shared)
+	{
+		report.error_bound = reduce_shared_partials<Model>(
+			stable,
+			intervals,
+			max_error,
+			envelopes,
+			report
+		);
+		mobile = stable;
+	}
+	else
+	{
+		sort_by_frequency(mobile);
+
+		// Split the budget between the sides by their sizes.
+		double const stable_share = static_cast<double>(stable.size())
+			/ static_cast<double>(std::max<std::size_t>(
+				1,
+				stable.size() + mobile.size()
+			));
+
+		// Mobile partials stay fixed while the stable ones are reduced.
+		std::array const stable_roles = {
+			ReductionRole{
+				1.0,
+				1.0,
+				{mobile, intervals.least, intervals.greatest}
+			}
+		};
+		auto const stable_chosen = plan_reduction<Model>(
+			stable,
+			stable_roles,
+			envelopes,
+			max_error * stable_share
+		);
+		for (auto const& candidate : stable_chosen)
+		{
+			report.error_bound += candidate.bound;
+		}
+		add_to_report(report, stable, stable_chosen);
+		stable = apply_reduction(stable, stable_chosen);
+
+		std::array const mobile_roles = {
+			ReductionRole{
+				intervals.least,
+				intervals.greatest,
+				{stable, 1.0, 1.0}
+			}
+		};
+		auto const mobile_chosen = plan_reduction<Model>(
+			mobile,
+			mobile_roles,
+			envelopes,
+			max_error - report.error_bound
+		);
+		for (auto const& candidate : mobile_chosen)
+		{
+			report.error_bound += candidate.bound;
+		}
+		add_to_report(report, mobile, mobile_chosen);
+		mobile = apply_reduction(mobile, mobile_chosen);
+	}
+
+	report.stable_after = stable.size();
+	report.mobile_after = mobile.size();
+	return report;
+}
+
+template auto reduce_partials<SetharesModel>(
+	std::vector<Partial>&,
+	std::vector<Partial>&,
+	bool,
+	IntervalBounds,
+	double
+) -> ReductionReport;
+template auto reduce_partials<ProductModel>(
+	std::vector<Partial>&,
+	std::vector<Partial>&,
+	bool,
+	IntervalBounds,
+	double
+) -> ReductionReport;
+template auto reduce_partials<VassilakisModel>(
+	std::vector<Partial>&,
+	std::vector<Partial>&,
+	bool,
+	IntervalBounds,
+	double
+) -> ReductionReport;
+} // namespace disscalc
@@ -0,0 +1,70 @@
+#ifndef DISSCALC_REDUCTION_HPP_INCLUDED
+#define DISSCALC_REDUCTION_HPP_INCLUDED
+
+#include "disscalc/models.hpp"
+#include "disscalc/partial.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace disscalc
+{
+/// Range of intervals over which a reduced timbre must stay accurate.
+struct IntervalBounds
+{
+	double least;
+	double greatest;
+};
+
+/// Summary of a partial reduction.
+struct ReductionReport
+{
+	std::size_t stable_before;
+	std::size_t stable_after;
+	std::size_t mobile_before;
+	std::size_t mobile_after;
+
+	/// Guaranteed bound on the absolute error of the dissonance.
+	double error_bound;
+
+	/// Amplitude of the loudest partial that was dropped, or 0 if none.
+	double amplitude_floor;
+
+	/// Largest frequency difference of two partials that were merged.
+	double merge_tolerance;
+};
+
+/** Drop and merge partials while bounding the change in dissonance.
+ *
+ * Partials are removed in order of how little they can affect the curve,
+ * either by dropping them or by merging them into a neighbouring partial,
+ * until doing more could exceed `max_error`. The bound on each operation
+ * accounts for the distance in frequency to every partial on the other side
+ * at any interval in `intervals`, so for every such interval the dissonance
+ * computed by `compute_dissonance<Model>` changes by at most `max_error`.
+ *
+ * The order of the partials is not preserved.
+ *
+ * @param stable the stable partials, which are reduced in place.
+ *
+ * @param mobile the mobile partials, which are reduced in place. When
+ * `shared` is true, this is instead replaced by the reduced stable partials.
+ *
+ * @param shared whether the same timbre is used for both notes.
+ *
+ * @param intervals the range of intervals at which the curve is evaluated.
+ *
+ * @param max_error the bound on the absolute error of the dissonance.
+ */
+template <DissonanceModelPolicy Model>
+[[nodiscard]]
+auto reduce_partials(
+	std::vector<Partial>& stable,
+	std::vector<Partial>& mobile,
+	bool shared,
+	IntervalBounds intervals,
+	double max_error
+) -> ReductionReport;
+} // namespace disscalc
+
+#endif
@@ -0,0 +1,284 @@
+#include "disscalc/scales.hpp"
+
+#include <cassert>
+#include <charconv>
+#include <cmath>
+#include <limits>
+#include <string_view>
+#include <system_error>
+
+namespace disscalc
+{
+[[nodiscard]]
+auto make_edo_scale(std::size_t divisions) -> Scale
+{
+	assert(divisions > 0);
+
+	Scale scale{std::to_string(divisions) + "-EDO", {}};
+	scale.pitches.reserve(divisions + 1);
+	for (std::size_t step = 0; step <= divisions; ++step)
+	{
+		scale.pitches.push_back(std::exp2(
+			static_cast<double>(step) / static_cast<double>(divisions)
+		));
+	}
+	return scale;
+}
+
+// Remove leading spaces and tabs.
+[[nodiscard]] static constexpr
+std::string_view trim_leading_space(std::string_view str) noexcept
+{
+	auto const first = str.find_first_not_of(" \t\r");
+	if (first == std::string_view::npos)
+	{
+		return {};
+	}
+	return str.substr(first);
+}
+
+// Try to parse a number at the start of `str`, advancing `str` past it.
+[[nodiscard]] static
+auto extract_number(std::string_view& str) noexcept -> std::optional<double>
+{
+	double value;
+	auto const [end, error] = std::from_chars(
+		str.data(),
+		str.data() + str.size(),
+		value
+	);
+	if (error != std::errc())
+	{
+		return std::nullopt;
+	}
+
+	str.remove_prefix(static_cast<std::size_t>(end - str.data()));
+	return value;
+}
+
+/*
+ * Parse the pitch on a single line of a Scala file as a ratio. Anything after
+ * the first token is a comment.
+ */
+[[nodiscard]] static
+auto parse_scala_pitch(std::string_view line) noexcept -> std::optional<double>
+{
+	line = trim_leading_space(line);
+	auto const token = line.substr(0, line.find_first_of(" \t\r"));
+	auto rest = token;
+
+	auto const first = extract_number(rest);
+	if (!first.has_value())
+	{
+		return std::nullopt;
+	}
+
+	// Cents are distinguished from ratios by containing a period.
+	if (token.find('.') != std::string_view::npos)
+	{
+		if (!rest.empty())
+		{
+			return std::nullopt;
+		}
+		return std::exp2(*first / 1200.0);
+	}
+
+	double ratio = *first;
+	if (rest.starts_with('/'))
+	{
+		rest.remove_prefix(1);
+		auto const denominator = extract_number(rest);
+		if (!denominator.has_value() || *denominator <= 0.0)
+		{
+			return std::nullopt;
+		}
+		ratio /= *denominator;
+	}
+
+	if (!rest.empty() || ratio <= 0.0)
+	{
+		return std::nullopt;
+	}
+	return ratio;
+}
+
+[[nodiscard]]
+auto read_scala_scale(std::istream& in, std::string name)
+	-> std::optional<Scale>
+{
+	// Read the next line that is not a comment.
+	std::string line;
+	auto const next_line = [&]
+	{
+		while (std::getline(in, line))
+		{
+			if (!line.starts_with('!'))
+			{
+				return true;
+			}
+		}
+		return false;
+	};
+
+	// The first line is a description, which is not used.
+	if (!next_line() || !next_line())
+	{
+		return std::nullopt;
+	}
+
+	std::size_t note_count;
+	auto const count_text = trim_leading_space(line);
+	auto const [count_end, count_error] = std::from_chars(
+		count_text.data(),
+		count_text.data() + count_text.size(),
+		note_count
+	);
+	if (count_error != std::errc() || note_count == 0)
+	{
+		return std::nullopt;
+	}
+
+	Scale scale{std::move(name), {1.0}};
+	scale.pitches.reserve(note_count + 1);
+	for (std::size_t i = 0; i < note_count; ++i)
+	{
+		if (!next_line())
+		{
+			return std::nullopt;
+		}
+
+		auto const pitch = parse_scala_pitch(line);
+		if (!pitch.has_value())
+		{
+			return std::nullopt;
+		}
+		scale.pitches.push_back(*pitch);
+	}
+
+	return scale;
+}
+
+// Depth-first branch-and-bound search for the least dissonant chord.
+class LeastChordSearch
+{
+public:
+	LeastChordSearch(
+		PairDissonances const& pairs,
+		std::size_t note_count,
+		std::size_t chord_size
+	)
+		: pairs_(pairs),
+		note_count_(note_count),
+		chord_size_(chord_size)
+	{
+		notes_.reserve(chord_size);
+
+		least_pair_ = std::numeric_limits<double>::infinity();
+		for (std::size_t i = 0; i < note_count; ++i)
+		{
+			for (std::size_t j = i + 1; j < note_count; ++j)
+			{
+				least_pair_ = std::min(least_pair_, pairs(i, j));
+			}
+		}
+	}
+
+	// Get the dissonance of the least dissonant chord, or NaN if none exist.
+	[[nodiscard]]
+	double run(void)
+	{
+		if (chord_size_ > note_count_)
+		{
+			return std::numeric_limits<double>::quiet_NaN();
+		}
+
+		best_ = std::numeric_limits<double>::infinity();
+		extend(0, 0.0);
+		return best_;
+	}
+
+private:
+	[[nodiscard]] static constexpr
+	std::size_t pair_count(std::size_t notes) noexcept
+	{
+		return notes * (notes - (notes > 0 ? 1 : 0)) / 2;
+	}
+
+	/*
+	 * Try every way of completing the chord in `notes_` using notes starting
+	 * at `first_note`, where `dissonance` is the dissonance of `notes_`.
+	 */
+	void extend(std::size_t first_note, double dissonance)
+	{
+		if (notes_.size() == chord_size_)
+		{
+			best_ = std::min(best_, dissonance);
+			return;
+		}
+
+		auto const missing_pairs =
+			pair_count(chord_size_) - pair_count(notes_.size());
+		double const lower_bound =
+			dissonance + static_cast<double>(missing_pairs) * least_pair_;
+		if (lower_bound >= best_)
+		{
+			return;
+		}
+
+		auto const missing_notes = chord_size_ - notes_.size();
+		for (
+			std::size_t note = first_note;
+			note + missing_notes <= note_count_;
+			++note
+		)
+		{
+			double added = 0.0;
+			for (auto const other : notes_)
+			{
+				added += pairs_(other, note);
+			}
+
+			notes_.push_back(note);
+			extend(note + 1, dissonance + added);
+			notes_.pop_back();
+		}
+	}
+
+	PairDissonances const& pairs_;
+	std::size_t note_count_;
+	std::size_t chord_size_;
+	double least_pair_;
+
+	std::vector<std::size_t> notes_;
+	double best_ = 0.0;
+};
+
+[[nodiscard]]
+auto summarize_scale(PairDissonances const& pairs, std::size_t max_chord_size)
+	-> ScaleEvaluation
+{
+	auto const pitch_count = pairs.pitch_count();
+	assert(pitch_count >= 2);
+
+	ScaleEvaluation evaluation{0.0, 0.0, {}};
+	for (std::size_t i = 0; i < pitch_count; ++i)
+	{
+		for (std::size_t j = i + 1; j < pitch_count; ++j)
+		{
+			evaluation.total += pairs(i, j);
+		}
+	}
+	evaluation.per_step =
+		evaluation.total / static_cast<double>(pitch_count - 1);
+
+	// Chords are built within one period, so the period itself is excluded.
+	for (std::size_t size = 3; size <= max_chord_size; ++size)
+	{
+		evaluation.least_chord_dissonances.push_back(
+			LeastChordSearch(pairs, pitch_count - 1, size).run()
+		);
+	}
+
+	return evaluation;
+}
+} // namespace disscalc
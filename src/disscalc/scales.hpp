@@ -0,0 +1,189 @@
+#ifndef DISSCALC_SCALES_HPP_INCLUDED
+#define DISSCALC_SCALES_HPP_INCLUDED
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace disscalc
+{
+/// A tuning, given as the pitches of one period above a tonic.
+struct Scale
+{
+	/// Name used to identify the scale in output.
+	std::string name;
+
+	/** Ratio of each pitch above the tonic.
+	 *
+	 * The first pitch is always the tonic itself (1.0), and the last is
+	 * the period (usually 2.0), so a scale with `n` steps has `n + 1`
+	 * pitches.
+	 */
+	std::vector<double> pitches;
+
+	/// Get the number of steps in a period.
+	[[nodiscard]]
+	std::size_t steps(void) const noexcept
+	{
+		return pitches.size() - 1;
+	}
+};
+
+/// Create an equal division of the octave with `divisions` steps.
+[[nodiscard]]
+auto make_edo_scale(std::size_t divisions) -> Scale;
+
+/** Read a scale in the Scala (.scl) format.
+ *
+ * Pitches containing a period are interpreted as cents, and the others as
+ * ratios such as "3/2" or "2". The implicit tonic is added to the start of the
+ * pitch list.
+ *
+ * @return the scale, or an empty optional if the input is malformed.
+ */
+[[nodiscard]]
+auto read_scala_scale(std::istream& in, std::string name)
+	-> std::optional<Scale>;
+
+/// Symmetric table of the dissonance between each pair of pitches in a scale.
+class PairDissonances
+{
+public:
+	explicit PairDissonances(std::size_t pitch_count)
+		: pitch_count_(pitch_count),
+		values_(pitch_count * pitch_count, 0.0)
+	{}
+
+	[[nodiscard]]
+	std::size_t pitch_count(void) const noexcept
+	{
+		return pitch_count_;
+	}
+
+	[[nodiscard]]
+	double operator()(std::size_t i, std::size_t j) const noexcept
+	{
+		return values_[i * pitch_count_ + j];
+	}
+
+	/// Set the dissonance of both `(i, j)` and `(j, i)`.
+	void set(std::size_t i, std::size_t j, double dissonance) noexcept
+	{
+		values_[i * pitch_count_ + j] = dissonance;
+		values_[j * pitch_count_ + i] = dissonance;
+	}
+
+private:
+	std::size_t pitch_count_;
+	std::vector<double> values_;
+};
+
+/// Relative difference below which two intervals of a scale are the same.
+constexpr double same_interval_tolerance = 1e-12;
+
+/** Compute the dissonance between every pair of pitches in `scale`.
+ *
+ * The interval of a pair is the ratio of the higher pitch to the lower one.
+ * Pairs spanning the same interval (to within rounding error) share a single
+ * call to `dissonance_at`, so an equal temperament with `n` steps only needs
+ * `n` evaluations.
+ */
+[[nodiscard]]
+auto compute_pair_dissonances(
+	Scale const& scale,
+	std::invocable<double> auto dissonance_at
+) -> PairDissonances
+{
+	struct Pair
+	{
+		double interval;
+		std::size_t low;
+		std::size_t high;
+	};
+
+	auto const& pitches = scale.pitches;
+
+	std::vector<Pair> pairs;
+	pairs.reserve(pitches.size() * (pitches.size() - 1) / 2);
+	for (std::size_t i = 0; i < pitches.size(); ++i)
+	{
+		for (std::size_t j = i + 1; j < pitches.size(); ++j)
+		{
+			double const interval = pitches[j] > pitches[i]
+				? pitches[j] / pitches[i]
+				: pitches[i] / pitches[j];
+			pairs.push_back({interval, i, j});
+		}
+	}
+	std::ranges::stable_sort(pairs, {}, &Pair::interval);
+
+	PairDissonances result(pitches.size());
+	double group_interval = 0.0;
+	double group_dissonance = 0.0;
+	for (auto const& pair : pairs)
+	{
+		if (
+			pair.interval - group_interval
+			> same_interval_tolerance * pair.interval
+		)
+		{
+			group_interval = pair.interval;
+			group_dissonance = std::invoke(dissonance_at, pair.interval);
+		}
+		result.set(pair.low, pair.high, group_dissonance);
+	}
+	return result;
+}
+
+/// Summary of the dissonance of a scale.
+struct ScaleEvaluation
+{
+	/// Sum of the dissonances of every pair of pitches, including the period.
+	double total;
+
+	/// `total` divided by the number of steps in the scale.
+	double per_step;
+
+	/** Dissonance of the least dissonant chord of each size.
+	 *
+	 * The first element is for three-note chords, the second for four-note
+	 * chords and so on. Chords are made of distinct pitches within a single
+	 * period, and their dissonance is the sum of the dissonances of each
+	 * pair of notes.
+	 */
+	std::vector<double> least_chord_dissonances;
+};
+
+/** Summarize precomputed pair dissonances of a scale.
+ *
+ * @param pairs the pair dissonances of every pitch, including the period.
+ *
+ * @param max_chord_size the largest chord size for which to find the least
+ * dissonant chord. Sizes below three do not produce any chords.
+ */
+[[nodiscard]]
+auto summarize_scale(PairDissonances const& pairs, std::size_t max_chord_size)
+	-> ScaleEvaluation;
+
+/// Compute pair dissonances of `scale` and summarize them.
+[[nodiscard]]
+auto evaluate_scale(
+	Scale const& scale,
+	std::invocable<double> auto dissonance_at,
+	std::size_t max_chord_size
+) -> ScaleEvaluation
+{
+	return summarize_scale(
+		compute_pair_dissonances(scale, std::move(dissonance_at)),
+		max_chord_size
+	);
+}
+} // namespace disscalc
+
+#endif
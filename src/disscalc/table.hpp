@@ -1,13 +1,37 @@
 #ifndef DISSCALC_TABLE_HPP_INCLUDED
 #define DISSCALC_TABLE_HPP_INCLUDED
 
+#include "disscalc/bounded-queue.hpp"
+#include "disscalc/interval-grid.hpp"
+
+#include <algorithm>
 #include <concepts>
+#include <cstddef>
 #include <functional>
 #include <iostream>
-#include <set>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace disscalc
 {
+/// A single row of a two-column table of doubles.
+struct TableRow
+{
+	double input;
+	double output;
+
+	/// Whether `input` came from the extra values rather than the range.
+	bool is_extra;
+};
+
+/// Range covering every row of any table.
+constexpr RowRange all_rows = {0, std::numeric_limits<std::size_t>::max()};
+
 /// Print a single row in a double table.
 inline
 void print_table_entry(std::ostream& out, double left, double right, char delimiter)
@@ -15,6 +39,222 @@ void print_table_entry(std::ostream& out, double left, double right, char delimi
 	out << left << delimiter << right << '\n';
 }
 
+/// Print a single row of a table with several values for each input.
+inline
+void print_wide_table_entry(
+	std::ostream& out,
+	double input,
+	std::span<double const> outputs,
+	char delimiter
+)
+{
+	out << input;
+	for (auto const output : outputs)
+	{
+		out << delimiter << output;
+	}
+	out << '\n';
+}
+
+/// Print a single row of a progressive table, tagged with its level.
+inline
+void print_progressive_table_entry(
+	std::ostream& out,
+	std::size_t level,
+	double input,
+	double output,
+	char delimiter
+)
+{
+	out << level << delimiter << input << delimiter << output << '\n';
+}
+
+/** Visit each left-side value of a table in order.
+ *
+ * The values are those of an `IntervalGrid` with the same arguments, so
+ * `extra_values` must be sorted without duplicates. No two values are the
+ * same.
+ *
+ * @param visit called as `visit(x, is_extra)` for each value `x`, where
+ * `is_extra` indicates that `x` came from `extra_values` and is not also in
+ * the range.
+ */
+void for_each_table_input(
+	double first,
+	double delta,
+	double last,
+	std::vector<double> const& extra_values,
+	std::invocable<double, bool> auto visit
+)
+{
+	for (auto const input : IntervalGrid(first, delta, last, extra_values))
+	{
+		std::invoke(visit, input.value, input.is_extra);
+	}
+}
+
+/// Count the rows of a table with the given inputs.
+[[nodiscard]] inline
+std::size_t count_table_rows(
+	double first,
+	double delta,
+	double last,
+	std::vector<double> const& extra_values
+)
+{
+	return IntervalGrid(first, delta, last, extra_values).size();
+}
+
+/** Lazily compute the rows of a table with the given inputs.
+ *
+ * The result is a view of `TableRow`s with the same kind of access as
+ * `inputs`, which is a range of `TableInput`s. `func` is called whenever a row
+ * is read, so rows of an `IntervalGrid` may be read in any order, or split
+ * into subranges handled by different threads, without computing any other
+ * rows.
+ */
+[[nodiscard]]
+auto table_rows(
+	std::ranges::viewable_range auto&& inputs,
+	std::invocable<double> auto func
+) requires std::convertible_to<
+	std::invoke_result_t<decltype(func), double>,
+	double
+>
+{
+	using Func = decltype(func);
+
+	return std::views::transform(
+		std::forward<decltype(inputs)>(inputs),
+		[func = std::move(func)](TableInput input)
+			noexcept(std::is_nothrow_invocable_v<Func const&, double>)
+		{
+			return TableRow{
+				input.value,
+				std::invoke(func, input.value),
+				input.is_extra
+			};
+		}
+	);
+}
+
+/// Greatest number of intervals between rows in the first progressive level.
+constexpr std::size_t progressive_first_level_intervals = 16;
+
+/** Visit the rows of a table in progressively finer levels.
+ *
+ * The first level holds every `stride`th row and the last row, where `stride`
+ * is the least power of two leaving at most
+ * `progressive_first_level_intervals` intervals between them. Each following
+ * level holds the rows halfway between those of all earlier levels, until
+ * every row has been visited exactly once.
+ *
+ * @param visit called as `visit(level, rows)` for each level in order, with
+ * the indices of the rows first visited at that level in increasing order.
+ */
+void for_each_progressive_level(
+	std::size_t row_count,
+	std::invocable<std::size_t, std::span<std::size_t const>> auto visit
+)
+{
+	if (row_count == 0)
+	{
+		return;
+	}
+
+	std::size_t stride = 1;
+	while ((row_count - 1) / stride > progressive_first_level_intervals)
+	{
+		stride *= 2;
+	}
+
+	std::vector<std::size_t> rows;
+	for (std::size_t level = 0; stride > 0; ++level, stride /= 2)
+	{
+		rows.clear();
+
+		// Rows at odd multiples of the stride are new, except in the first.
+		auto const first = level == 0 ? 0 : stride;
+		auto const step = level == 0 ? stride : 2 * stride;
+		for (auto i = first; i < row_count - 1; i += step)
+		{
+			rows.push_back(i);
+		}
+		if (level == 0)
+		{
+			rows.push_back(row_count - 1);
+		}
+		std::invoke(visit, level, std::span<std::size_t const>(rows));
+	}
+}
+
+/** Get the rows handled by one shard of a table.
+ *
+ * The rows are split into `shard_count` contiguous blocks whose sizes differ
+ * by at most one, so concatenating the output of every shard in order gives
+ * the whole table.
+ */
+[[nodiscard]] constexpr
+RowRange get_shard_rows(
+	std::size_t row_count,
+	std::size_t shard_index,
+	std::size_t shard_count
+) noexcept
+{
+	auto const base_size = row_count / shard_count;
+	auto const remainder = row_count % shard_count;
+	auto const start_of = [&](std::size_t shard)
+	{
+		return shard * base_size + std::min(shard, remainder);
+	};
+	return {start_of(shard_index), start_of(shard_index + 1)};
+}
+
+/** Compute the rows of a table within a range of row indices.
+ *
+ * The inputs are those of `for_each_table_input`, and `func` is only called
+ * for inputs of rows within `rows`, which are found without going through the
+ * rows before them.
+ *
+ * @param visit called as `visit(index, row)` for each computed row, in order.
+ */
+void for_each_table_row(
+	double first,
+	double delta,
+	double last,
+	std::invocable<double> auto func,
+	std::vector<double> const& extra_values,
+	RowRange rows,
+	std::invocable<std::size_t, TableRow const&> auto visit
+) requires std::convertible_to<
+	std::invoke_result_t<decltype(func), double>,
+	double
+>
+{
+	IntervalGrid const grid(first, delta, last, extra_values);
+	auto const inputs = grid.rows(rows);
+	auto index = std::begin(inputs).row();
+	for (auto const& row : table_rows(inputs, std::move(func)))
+	{
+		std::invoke(visit, index++, row);
+	}
+}
+
+/// Number of rows passed at once from the computing to the printing thread.
+constexpr std::size_t table_block_size = 1024;
+
+/// Number of blocks of rows that may wait to be printed.
+constexpr std::size_t table_block_capacity = 4;
+
+/// Consecutive rows of a table.
+struct TableRowBlock
+{
+	/// Index of the first row.
+	std::size_t first_index;
+
+	std::vector<TableRow> rows;
+};
+
 /** Print a two-column table of doubles as delimiter separated values.
  *
  * The "table" comes in the form of a range of doubles and a function object
@@ -40,8 +280,19 @@ void print_table_entry(std::ostream& out, double left, double right, char delimi
  *
  * @param delimiter the delimiter separating the left and right of the table.
  *
- * @param extra_values a set of values possibly outside of the main range which
- * are also on the left side.
+ * @param extra_values values, sorted without duplicates and possibly outside of
+ * the main range, which are also on the left side.
+ *
+ * @param rows the indices of the rows to print. `func` is only called for
+ * these rows.
+ *
+ * @param after_row called with the index of each row after it is printed.
+ *
+ * Rows are computed on the calling thread while blocks of previously computed
+ * rows are printed on another, so slow output does not hold up computation
+ * and vice versa. At most `table_block_capacity` blocks wait to be printed,
+ * so memory use does not depend on the size of the table. `after_row` is
+ * called on the printing thread.
  */
 void print_table_as_dsv(
 	std::ostream& out,
@@ -50,50 +301,92 @@ void print_table_as_dsv(
 	double last,
 	std::invocable<double> auto func,
 	char delimiter,
-	std::set<double> const& extra_values
+	std::vector<double> const& extra_values,
+	RowRange rows,
+	std::invocable<std::size_t> auto after_row
 ) requires std::convertible_to<
 	std::invoke_result_t<decltype(func), double>,
 	double
 >
 {
-	auto extra_begin = std::cbegin(extra_values);
-	auto const extra_end = std::cend(extra_values);
+	BoundedQueue<TableRowBlock> blocks(table_block_capacity);
 
-	for (; first <= last; first += delta)
+	// Joined automatically on destruction, before the queue is destroyed.
+	std::jthread printer([&]
 	{
-		// Print and skip any extra values not yet printed.
-		for (; extra_begin != extra_end; ++extra_begin)
+		while (auto block = blocks.pop())
 		{
-			// Skip already covered values.
-			if (*extra_begin == first)
+			auto index = block->first_index;
+			for (auto const& row : block->rows)
 			{
-				++extra_begin;
-				break;
+				print_table_entry(out, row.input, row.output, delimiter);
+				std::invoke(after_row, index++);
 			}
-			if (*extra_begin >= first)
+		}
+	});
+
+	/*
+	 * Destroyed before the printer is joined, so the printer stops waiting for
+	 * blocks even if computing a row throws.
+	 */
+	QueueCloser const closer(blocks);
+
+	TableRowBlock block{0, {}};
+	block.rows.reserve(table_block_size);
+	for_each_table_row(
+		first,
+		delta,
+		last,
+		std::move(func),
+		extra_values,
+		rows,
+		[&](std::size_t index, TableRow const& row)
+		{
+			if (block.rows.empty())
 			{
-				break;
+				block.first_index = index;
 			}
-			print_table_entry(
-				out,
-				*extra_begin,
-				std::invoke(func, *extra_begin),
-				delimiter
-			);
-		}
-		print_table_entry(out, first, std::invoke(func, first), delimiter);
-	}
+			block.rows.push_back(row);
 
-	for (; extra_begin != extra_end; ++extra_begin)
+			if (block.rows.size() == table_block_size)
+			{
+				blocks.push(std::exchange(block, {0, {}}));
+				block.rows.reserve(table_block_size);
+			}
+		}
+	);
+	if (!block.rows.empty())
 	{
-		print_table_entry(
-			out,
-			*extra_begin,
-			std::invoke(func, *extra_begin),
-			delimiter
-		);
+		blocks.push(std::move(block));
 	}
 }
+
+/// Print every row of a table as delimiter separated values.
+void print_table_as_dsv(
+	std::ostream& out,
+	double first,
+	double delta,
+	double last,
+	std::invocable<double> auto func,
+	char delimiter,
+	std::vector<double> const& extra_values
+) requires std::convertible_to<
+	std::invoke_result_t<decltype(func), double>,
+	double
+>
+{
+	print_table_as_dsv(
+		out,
+		first,
+		delta,
+		last,
+		std::move(func),
+		delimiter,
+		extra_values,
+		all_rows,
+		[](std::size_t) noexcept {}
+	);
+}
 } // namespace disscalc
 
 #endif
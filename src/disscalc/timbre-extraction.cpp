@@ -0,0 +1,190 @@
+#include "disscalc/timbre-extraction.hpp"
+
+#include "disscalc/fft.hpp"
+#include "disscalc/wav.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numbers>
+
+namespace disscalc
+{
+SpectrumAccumulator::SpectrumAccumulator(std::size_t frame_size)
+	: window_(frame_size),
+	transform_(frame_size),
+	power_sums_(frame_size / 2 + 1, 0.0)
+{
+	assert(is_power_of_two(frame_size));
+
+	for (std::size_t i = 0; i < frame_size; ++i)
+	{
+		window_[i] = 0.5 - 0.5 * std::cos(
+			2.0 * std::numbers::pi * static_cast<double>(i)
+			/ static_cast<double>(frame_size)
+		);
+	}
+	pending_.reserve(frame_size);
+}
+
+void SpectrumAccumulator::analyze(std::span<double const> frame)
+{
+	std::ranges::fill(transform_, 0.0);
+	for (std::size_t i = 0; i < frame.size(); ++i)
+	{
+		transform_[i] = frame[i] * window_[i];
+	}
+
+	fft(transform_);
+
+	for (std::size_t k = 0; k < power_sums_.size(); ++k)
+	{
+		power_sums_[k] += std::norm(transform_[k]);
+	}
+	++frame_count_;
+}
+
+void SpectrumAccumulator::add_samples(std::span<double const> samples)
+{
+	auto const frame_size = window_.size();
+	auto const hop = frame_size / 2;
+
+	while (!samples.empty())
+	{
+		auto const taken = std::min(
+			samples.size(),
+			frame_size - pending_.size()
+		);
+		pending_.insert(
+			std::end(pending_),
+			std::begin(samples),
+			std::begin(samples) + static_cast<std::ptrdiff_t>(taken)
+		);
+		samples = samples.subspan(taken);
+
+		if (pending_.size() == frame_size)
+		{
+			analyze(pending_);
+
+			// Keep the second half, which starts the next frame.
+			pending_.erase(
+				std::begin(pending_),
+				std::begin(pending_) + static_cast<std::ptrdiff_t>(hop)
+			);
+		}
+	}
+}
+
+[[nodiscard]]
+auto SpectrumAccumulator::finish(void) -> std::vector<double>
+{
+	if (frame_count_ == 0)
+	{
+		analyze(pending_);
+	}
+
+	std::vector<double> result(power_sums_.size());
+	std::ranges::transform(
+		power_sums_,
+		std::begin(result),
+		[&](double power_sum) noexcept
+		{
+			return std::sqrt(power_sum / static_cast<double>(frame_count_));
+		}
+	);
+	return result;
+}
+
+[[nodiscard]]
+auto find_spectral_peaks(
+	std::span<double const> magnitudes,
+	double bin_width,
+	PeakSettings const& settings
+) -> std::vector<Partial>
+{
+	std::vector<Partial> peaks;
+
+	// The first and last bins cannot be local maxima.
+	for (std::size_t k = 1; k + 1 < magnitudes.size(); ++k)
+	{
+		double const left = magnitudes[k - 1];
+		double const center = magnitudes[k];
+		double const right = magnitudes[k + 1];
+		if (!(center > left && center >= right) || left <= 0.0 || right <= 0.0)
+		{
+			continue;
+		}
+
+		// Vertex of the parabola through the log magnitudes.
+		double const log_left = std::log(left);
+		double const log_center = std::log(center);
+		double const log_right = std::log(right);
+		double const curvature = log_left - 2.0 * log_center + log_right;
+		double const offset = curvature == 0.0
+			? 0.0
+			: 0.5 * (log_left - log_right) / curvature;
+
+		peaks.push_back({
+			(static_cast<double>(k) + offset) * bin_width,
+			std::exp(log_center - 0.25 * (log_left - log_right) * offset)
+		});
+	}
+
+	if (peaks.empty())
+	{
+		return peaks;
+	}
+
+	std::ranges::stable_sort(peaks, std::ranges::greater(), &Partial::amplitude);
+
+	double const strongest = peaks.front().amplitude;
+	double const least_amplitude =
+		strongest * std::pow(10.0, settings.threshold_db / 20.0);
+	auto const kept = std::ranges::find_if(
+		peaks,
+		[&](Partial p) noexcept { return p.amplitude < least_amplitude; }
+	);
+	peaks.erase(kept, std::end(peaks));
+	if (settings.max_peaks != 0 && peaks.size() > settings.max_peaks)
+	{
+		peaks.resize(settings.max_peaks);
+	}
+
+	for (auto& peak : peaks)
+	{
+		peak.amplitude /= strongest;
+	}
+	std::ranges::stable_sort(peaks, {}, &Partial::frequency);
+
+	return peaks;
+}
+
+[[nodiscard]]
+auto extract_timbre_from_wav(
+	std::istream& in,
+	std::size_t frame_size,
+	PeakSettings const& settings
+) -> std::optional<std::vector<Partial>>
+{
+	WavReader reader(in);
+	if (!reader.is_valid())
+	{
+		return std::nullopt;
+	}
+
+	SpectrumAccumulator accumulator(frame_size);
+	std::vector<double> block(frame_size);
+	for (
+		auto count = reader.read_mono(block);
+		count > 0;
+		count = reader.read_mono(block)
+	)
+	{
+		accumulator.add_samples(std::span(block).first(count));
+	}
+
+	double const bin_width = static_cast<double>(reader.format().sample_rate)
+		/ static_cast<double>(frame_size);
+	return find_spectral_peaks(accumulator.finish(), bin_width, settings);
+}
+} // namespace disscalc
@@ -0,0 +1,104 @@
+#ifndef DISSCALC_TIMBRE_EXTRACTION_HPP_INCLUDED
+#define DISSCALC_TIMBRE_EXTRACTION_HPP_INCLUDED
+
+#include "disscalc/partial.hpp"
+
+#include <complex>
+#include <cstddef>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace disscalc
+{
+/// Settings controlling which spectral peaks become partials.
+struct PeakSettings
+{
+	/// Least level of a peak, in decibels relative to the strongest peak.
+	double threshold_db = -60.0;
+
+	/// Largest number of peaks kept, strongest first. Zero means no limit.
+	std::size_t max_peaks = 64;
+};
+
+/** Average magnitude spectrum of a stream of samples.
+ *
+ * The samples are split into Hann-windowed frames overlapping by half, and the
+ * power spectra of the frames are averaged (Welch's method). Only one frame of
+ * samples is held at a time, so memory use does not depend on the length of
+ * the stream.
+ */
+class SpectrumAccumulator
+{
+public:
+	/// Create an accumulator with the given frame size, a power of two.
+	explicit SpectrumAccumulator(std::size_t frame_size);
+
+	/// Add the next samples of the stream.
+	void add_samples(std::span<double const> samples);
+
+	/** End the stream and get the average magnitude of each frequency bin.
+	 *
+	 * Bin `k` is centered on `k * sample_rate / frame_size`, and there are
+	 * `frame_size / 2 + 1` bins. If the stream was shorter than one frame,
+	 * it is padded with zeros.
+	 */
+	[[nodiscard]]
+	auto finish(void) -> std::vector<double>;
+
+private:
+	// Add the power spectrum of `frame` to `power_sums_`.
+	void analyze(std::span<double const> frame);
+
+	std::vector<double> window_;
+
+	// Samples of the frame currently being filled.
+	std::vector<double> pending_;
+
+	// Buffer reused between frames.
+	std::vector<std::complex<double>> transform_;
+
+	std::vector<double> power_sums_;
+	std::size_t frame_count_ = 0;
+};
+
+/** Find peaks in a magnitude spectrum and convert them into partials.
+ *
+ * Peak frequencies and amplitudes are refined by fitting a parabola to the
+ * logarithm of the magnitudes around each peak. Amplitudes are normalized so
+ * that the strongest partial has an amplitude of 1, and the partials are
+ * sorted by frequency.
+ *
+ * @param magnitudes the magnitude of each frequency bin, starting at 0 Hz.
+ *
+ * @param bin_width the distance between bins in Hz.
+ *
+ * @param settings which peaks to keep.
+ */
+[[nodiscard]]
+auto find_spectral_peaks(
+	std::span<double const> magnitudes,
+	double bin_width,
+	PeakSettings const& settings
+) -> std::vector<Partial>;
+
+/** Read a WAV file and extract the partials of its average spectrum.
+ *
+ * @param in the WAV file, opened in binary mode.
+ *
+ * @param frame_size the size of each analysis frame, a power of two.
+ *
+ * @param settings which peaks to keep.
+ *
+ * @return the partials, or an empty optional if the file could not be read.
+ */
+[[nodiscard]]
+auto extract_timbre_from_wav(
+	std::istream& in,
+	std::size_t frame_size,
+	PeakSettings const& settings
+) -> std::optional<std::vector<Partial>>;
+} // namespace disscalc
+
+#endif
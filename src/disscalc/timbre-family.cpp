@@ -0,0 +1,48 @@
+#include "disscalc/timbre-family.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace disscalc
+{
+[[nodiscard]]
+auto apply_timbre_parameter(
+	std::span<Partial const> base,
+	TimbreParameter parameter,
+	double value
+) -> std::vector<Partial>
+{
+	std::vector<Partial> partials(base.begin(), base.end());
+	if (partials.empty())
+	{
+		return partials;
+	}
+
+	auto const lowest = std::ranges::min(
+		partials,
+		{},
+		&Partial::frequency
+	).frequency;
+
+	for (auto& partial : partials)
+	{
+		auto const ratio = partial.frequency / lowest;
+		switch (parameter)
+		{
+		case TimbreParameter::stretch:
+			partial.frequency = lowest * std::pow(value, std::log2(ratio));
+			break;
+		case TimbreParameter::rolloff:
+			partial.amplitude *= std::pow(ratio, -value);
+			break;
+		case TimbreParameter::inharmonicity:
+			partial.frequency *= std::sqrt(1.0 + value * ratio * ratio);
+			break;
+		default:
+			break;
+		}
+	}
+
+	return partials;
+}
+} // namespace disscalc
@@ -0,0 +1,191 @@
+#ifndef DISSCALC_TIMBRE_FAMILY_HPP_INCLUDED
+#define DISSCALC_TIMBRE_FAMILY_HPP_INCLUDED
+
+#include "disscalc/parallel.hpp"
+#include "disscalc/partial.hpp"
+
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace disscalc
+{
+/// Parameter varied across a family of timbres derived from a base timbre.
+enum struct TimbreParameter
+{
+	/** Pseudo-octave of the partials, where 2 leaves them unchanged.
+	 *
+	 * A partial `r` times the lowest frequency is moved to `value^log2(r)`
+	 * times it.
+	 */
+	stretch,
+
+	/** Exponent of an extra spectral rolloff, where 0 changes nothing.
+	 *
+	 * A partial `r` times the lowest frequency has its amplitude multiplied
+	 * by `r^-value`.
+	 */
+	rolloff,
+
+	/** Inharmonicity coefficient of a stiff string, where 0 changes nothing.
+	 *
+	 * A partial `r` times the lowest frequency has its frequency multiplied by
+	 * `sqrt(1 + value * r^2)`.
+	 */
+	inharmonicity,
+};
+
+/// Find the parameter with the given name.
+[[nodiscard]] constexpr
+auto find_timbre_parameter(std::string_view name) noexcept
+	-> std::optional<TimbreParameter>
+{
+	if (name == "stretch")
+	{
+		return TimbreParameter::stretch;
+	}
+	if (name == "rolloff")
+	{
+		return TimbreParameter::rolloff;
+	}
+	if (name == "inharmonicity")
+	{
+		return TimbreParameter::inharmonicity;
+	}
+	return std::nullopt;
+}
+
+/// Indicate whether `value` gives positive partials for `parameter`.
+[[nodiscard]] constexpr
+bool is_valid_parameter_value(TimbreParameter parameter, double value) noexcept
+{
+	switch (parameter)
+	{
+	case TimbreParameter::stretch:
+		return value > 0.0;
+	case TimbreParameter::rolloff:
+		return true;
+	case TimbreParameter::inharmonicity:
+		return value >= 0.0;
+	default:
+		return false;
+	}
+}
+
+/// Evenly spaced values of a timbre parameter, including both ends.
+struct ParameterSweep
+{
+	TimbreParameter parameter;
+	double first;
+	double last;
+
+	/// Number of values, which is at least 1.
+	std::size_t count;
+
+	/// Get the `i`th value of the sweep.
+	[[nodiscard]]
+	double value(std::size_t i) const noexcept
+	{
+		assert(i < count);
+		if (count == 1)
+		{
+			return first;
+		}
+		auto const t = static_cast<double>(i) / static_cast<double>(count - 1);
+		return first + t * (last - first);
+	}
+};
+
+/// Apply a value of a parameter to the partials of `base`.
+[[nodiscard]]
+auto apply_timbre_parameter(
+	std::span<Partial const> base,
+	TimbreParameter parameter,
+	double value
+) -> std::vector<Partial>;
+
+/// Dissonances of a family of timbres at each of several intervals.
+struct DissonanceMatrix
+{
+	/// Value of the parameter for each row.
+	std::vector<double> parameters;
+
+	/// Interval for each column.
+	std::vector<double> intervals;
+
+	/// Dissonances of every row in order, each holding every column.
+	std::vector<double> values;
+
+	[[nodiscard]]
+	double at(std::size_t row, std::size_t column) const noexcept
+	{
+		return values[row * intervals.size() + column];
+	}
+};
+
+/** Compute the dissonance of each timbre of a family at each interval.
+ *
+ * Rows are computed in parallel, each for its own timbre.
+ *
+ * @param base the timbre the family is derived from.
+ *
+ * @param mobile the timbre of the raised note, or empty to use the same timbre
+ * as the lower note.
+ *
+ * @param thread_count the maximum number of threads, as for `parallel_for`.
+ *
+ * @param dissonance_between function giving the dissonance of an interval
+ * between a stable and mobile timbre.
+ */
+[[nodiscard]]
+auto compute_timbre_family(
+	std::span<Partial const> base,
+	std::span<Partial const> mobile,
+	ParameterSweep const& sweep,
+	std::vector<double> intervals,
+	std::size_t thread_count,
+	std::invocable<
+		std::span<Partial const>,
+		std::span<Partial const>,
+		double
+	> auto dissonance_between
+) -> DissonanceMatrix
+{
+	DissonanceMatrix matrix;
+	matrix.intervals = std::move(intervals);
+	matrix.parameters.resize(sweep.count);
+	matrix.values.resize(sweep.count * matrix.intervals.size());
+
+	parallel_for(sweep.count, thread_count, [&](std::size_t row)
+	{
+		auto const parameter = sweep.value(row);
+		auto const stable = apply_timbre_parameter(
+			base,
+			sweep.parameter,
+			parameter
+		);
+		std::span<Partial const> const this_mobile = mobile.empty()
+			? stable
+			: mobile;
+
+		matrix.parameters[row] = parameter;
+		auto const columns = matrix.intervals.size();
+		for (std::size_t column = 0; column < columns; ++column)
+		{
+			matrix.values[row * columns + column] = dissonance_between(
+				stable,
+				this_mobile,
+				matrix.intervals[column]
+			);
+		}
+	});
+
+	return matrix;
+}
+} // namespace disscalc
+
+#endif
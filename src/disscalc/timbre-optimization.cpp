@@ -0,0 +1,414 @@
+#include "disscalc/timbre-optimization.hpp"
+
+#include "disscalc/dissonance.hpp"
+#include "disscalc/parallel.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numbers>
+
+namespace disscalc
+{
+[[nodiscard]]
+auto find_scale_intervals(Scale const& scale) -> std::vector<WeightedInterval>
+{
+	auto const& pitches = scale.pitches;
+
+	std::vector<double> pair_intervals;
+	for (std::size_t i = 0; i < pitches.size(); ++i)
+	{
+		for (std::size_t j = i + 1; j < pitches.size(); ++j)
+		{
+			pair_intervals.push_back(
+				pitches[j] > pitches[i]
+					? pitches[j] / pitches[i]
+					: pitches[i] / pitches[j]
+			);
+		}
+	}
+	std::ranges::stable_sort(pair_intervals);
+
+	// Grouped in the same way as by `compute_pair_dissonances`.
+	std::vector<WeightedInterval> intervals;
+	for (auto const interval : pair_intervals)
+	{
+		if (
+			intervals.empty()
+			|| interval - intervals.back().interval
+				> same_interval_tolerance * interval
+		)
+		{
+			intervals.push_back({interval, 0.0});
+		}
+		intervals.back().count += 1.0;
+	}
+	return intervals;
+}
+
+// Scaled distance between two frequencies and its derivative by each.
+struct ScaledDistance
+{
+	double x;
+	double slope_a;
+	double slope_b;
+};
+
+template <DissonanceModelPolicy Model>
+[[nodiscard]] static
+ScaledDistance find_scaled_distance(double freq_a, double freq_b) noexcept
+{
+	double const least_freq = std::min(freq_a, freq_b);
+	double const s = Model::dstar / (Model::s1 * least_freq + Model::s2);
+	double const x = s * std::abs(freq_b - freq_a);
+
+	// Moving the lower partial also changes the scale of the distance.
+	double const lower_slope = -s * (1.0 + x * Model::s1 / Model::dstar);
+	if (freq_a < freq_b)
+	{
+		return {x, lower_slope, s};
+	}
+	if (freq_a > freq_b)
+	{
+		return {x, s, lower_slope};
+	}
+	return {x, 0.0, 0.0};
+}
+
+template <DissonanceModelPolicy Model>
+[[nodiscard]]
+auto compute_timbre_dissonance(
+	std::span<Partial const> partials,
+	std::span<WeightedInterval const> intervals,
+	std::size_t thread_count
+) -> TimbreDissonance
+{
+	auto const count = partials.size();
+	TimbreDissonance result{
+		0.0,
+		std::vector<double>(count, 0.0),
+		std::vector<double>(count, 0.0)
+	};
+
+	/*
+	 * Each partial gathers every term involving it, both as the stable and as
+	 * the mobile partial, so no two threads write to the same slope. Its
+	 * share of the total is that of the pairs where it is the stable partial.
+	 */
+	std::vector<double> totals(count, 0.0);
+	parallel_for(count, thread_count, [&](std::size_t k) noexcept
+	{
+		auto const own = partials[k];
+		double total = 0.0;
+		double frequency_slope = 0.0;
+		double amplitude_slope = 0.0;
+		for (auto const [interval, weight] : intervals)
+		{
+			for (auto const other : partials)
+			{
+				// The partial is stable and `other` is raised by the interval.
+				auto const up = find_scaled_distance<Model>(
+					own.frequency,
+					other.frequency * interval
+				);
+				double const up_weight = weight
+					* Model::weight(own.amplitude, other.amplitude);
+				total += up_weight * roughness_curve<Model>(up.x);
+				frequency_slope += up_weight * up.slope_a
+					* roughness_curve_slope<Model>(up.x);
+				amplitude_slope += weight
+					* Model::weight_slope(own.amplitude, other.amplitude)
+					* roughness_curve<Model>(up.x);
+
+				// The partial is raised by the interval against `other`.
+				auto const down = find_scaled_distance<Model>(
+					other.frequency,
+					own.frequency * interval
+				);
+				double const down_weight = weight
+					* Model::weight(other.amplitude, own.amplitude);
+				frequency_slope += down_weight * down.slope_b * interval
+					* roughness_curve_slope<Model>(down.x);
+				amplitude_slope += weight
+					* Model::weight_slope(own.amplitude, other.amplitude)
+					* roughness_curve<Model>(down.x);
+			}
+		}
+		totals[k] = total;
+		result.frequency_slopes[k] = frequency_slope;
+		result.amplitude_slopes[k] = amplitude_slope;
+	});
+
+	for (auto const total : totals)
+	{
+		result.total += total;
+	}
+	return result;
+}
+
+/*
+ * Bring `amplitudes` to the nearest values within `[lower, upper]` with the
+ * given sum, which must be reachable. These are `clamp(a - shift)` for a
+ * single shift, which is found by bisection since the sum falls as the shift
+ * grows.
+ */
+static
+void project_amplitudes(
+	std::span<double> amplitudes,
+	std::span<double const> lower,
+	std::span<double const> upper,
+	double sum
+) noexcept
+{
+	double least_shift = 0.0;
+	double greatest_shift = 0.0;
+	for (std::size_t i = 0; i < amplitudes.size(); ++i)
+	{
+		least_shift = std::min(least_shift, amplitudes[i] - upper[i]);
+		greatest_shift = std::max(greatest_shift, amplitudes[i] - lower[i]);
+	}
+
+	auto const shifted_sum = [&](double shift) noexcept
+	{
+		double total = 0.0;
+		for (std::size_t i = 0; i < amplitudes.size(); ++i)
+		{
+			total += std::clamp(amplitudes[i] - shift, lower[i], upper[i]);
+		}
+		return total;
+	};
+
+	constexpr int bisection_steps = 100;
+	for (int step = 0; step < bisection_steps; ++step)
+	{
+		double const middle = 0.5 * (least_shift + greatest_shift);
+		(shifted_sum(middle) > sum ? least_shift : greatest_shift) = middle;
+	}
+
+	double const shift = 0.5 * (least_shift + greatest_shift);
+	for (std::size_t i = 0; i < amplitudes.size(); ++i)
+	{
+		amplitudes[i] = std::clamp(amplitudes[i] - shift, lower[i], upper[i]);
+	}
+}
+
+/*
+ * Lengths of step tried at once, as multiples of the length of the last
+ * successful step, from four times longer down to 32 times shorter.
+ */
+constexpr std::size_t step_candidate_count = 8;
+
+// Step length below which the timbre is considered to no longer improve.
+constexpr double least_step = 1e-9;
+
+template <DissonanceModelPolicy Model>
+[[nodiscard]]
+auto optimize_timbre(
+	std::span<Partial const> start,
+	std::span<WeightedInterval const> intervals,
+	TimbreOptimizationSettings const& settings,
+	std::size_t thread_count
+) -> TimbreOptimization
+{
+	auto const total_of = [&](std::span<Partial const> partials) noexcept
+	{
+		double total = 0.0;
+		for (auto const [interval, count] : intervals)
+		{
+			total += count
+				* compute_dissonance<Model>(partials, partials, interval);
+		}
+		return total;
+	};
+
+	auto const count = start.size();
+	bool const moves_frequencies
+		= settings.parameters != OptimizedParameters::amplitudes;
+	bool const moves_amplitudes
+		= settings.parameters != OptimizedParameters::frequencies;
+
+	// Bounds on the logarithm of each frequency and on each amplitude.
+	double const log_range
+		= settings.frequency_range * std::numbers::ln2 / 1200.0;
+	std::vector<double> least_logs(count);
+	std::vector<double> greatest_logs(count);
+	std::vector<double> least_amplitudes(count);
+	std::vector<double> greatest_amplitudes(count);
+	double amplitude_sum = 0.0;
+	double loudest = 0.0;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		double const log_frequency = std::log(start[i].frequency);
+		least_logs[i] = log_frequency - log_range;
+		greatest_logs[i] = log_frequency + log_range;
+
+		double const amplitude = start[i].amplitude;
+		least_amplitudes[i] = amplitude / settings.amplitude_range;
+		greatest_amplitudes[i] = amplitude * settings.amplitude_range;
+		amplitude_sum += amplitude;
+		loudest = std::max(loudest, amplitude);
+	}
+
+	TimbreOptimization result{
+		std::vector<Partial>(start.begin(), start.end()),
+		total_of(start),
+		0.0,
+		0
+	};
+	auto& current = result.partials;
+	double current_total = result.initial_dissonance;
+
+	/*
+	 * Steps are measured as a fraction of the frequency range and of the
+	 * loudest amplitude, moved by the partial with the steepest slope.
+	 */
+	double step = 0.125;
+	std::vector<double> log_slopes(count);
+	std::vector<double> amplitude_slopes(count);
+	std::array<std::vector<Partial>, step_candidate_count> candidates;
+	std::array<std::vector<double>, step_candidate_count> amplitudes;
+	std::array<double, step_candidate_count> totals;
+	std::array<double, step_candidate_count> steps;
+
+	for (; result.iterations < settings.max_iterations; ++result.iterations)
+	{
+		auto const gradient = compute_timbre_dissonance<Model>(
+			current,
+			intervals,
+			thread_count
+		);
+
+		double steepest_log = 0.0;
+		double steepest_amplitude = 0.0;
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			log_slopes[i] = moves_frequencies
+				? current[i].frequency * gradient.frequency_slopes[i]
+				: 0.0;
+			amplitude_slopes[i] = moves_amplitudes
+				? gradient.amplitude_slopes[i]
+				: 0.0;
+			steepest_log = std::max(steepest_log, std::abs(log_slopes[i]));
+			steepest_amplitude = std::max(
+				steepest_amplitude,
+				std::abs(amplitude_slopes[i])
+			);
+		}
+		if (steepest_log == 0.0 && steepest_amplitude == 0.0)
+		{
+			break;
+		}
+		double const log_scale = steepest_log == 0.0
+			? 0.0
+			: log_range / steepest_log;
+		double const amplitude_scale = steepest_amplitude == 0.0
+			? 0.0
+			: loudest / steepest_amplitude;
+
+		parallel_for(
+			step_candidate_count,
+			thread_count,
+			[&](std::size_t c) noexcept
+			{
+				double const length = std::min(
+					1.0,
+					std::ldexp(step, 2 - static_cast<int>(c))
+				);
+				auto& candidate = candidates[c];
+				auto& candidate_amplitudes = amplitudes[c];
+				candidate.assign(current.begin(), current.end());
+
+				for (std::size_t i = 0; moves_frequencies && i < count; ++i)
+				{
+					double const log_frequency = std::log(current[i].frequency)
+						- length * log_scale * log_slopes[i];
+					candidate[i].frequency = std::exp(std::clamp(
+						log_frequency,
+						least_logs[i],
+						greatest_logs[i]
+					));
+				}
+				if (moves_amplitudes)
+				{
+					candidate_amplitudes.resize(count);
+					for (std::size_t i = 0; i < count; ++i)
+					{
+						candidate_amplitudes[i] = current[i].amplitude
+							- length * amplitude_scale * amplitude_slopes[i];
+					}
+					project_amplitudes(
+						candidate_amplitudes,
+						least_amplitudes,
+						greatest_amplitudes,
+						amplitude_sum
+					);
+					for (std::size_t i = 0; i < count; ++i)
+					{
+						candidate[i].amplitude = candidate_amplitudes[i];
+					}
+				}
+
+				steps[c] = length;
+				totals[c] = total_of(candidate);
+			}
+		);
+
+		auto const best = static_cast<std::size_t>(
+			std::ranges::min_element(totals) - totals.begin()
+		);
+		if (totals[best] < current_total)
+		{
+			current.swap(candidates[best]);
+			current_total = totals[best];
+			step = steps[best];
+		}
+		else
+		{
+			// Even the shortest step overshot, so try much shorter ones.
+			step = std::ldexp(step, -static_cast<int>(step_candidate_count));
+			if (step < least_step)
+			{
+				break;
+			}
+		}
+	}
+
+	result.final_dissonance = current_total;
+	return result;
+}
+
+template auto compute_timbre_dissonance<SetharesModel>(
+	std::span<Partial const>,
+	std::span<WeightedInterval const>,
+	std::size_t
+) -> TimbreDissonance;
+template auto compute_timbre_dissonance<ProductModel>(
+	std::span<Partial const>,
+	std::span<WeightedInterval const>,
+	std::size_t
+) -> TimbreDissonance;
+template auto compute_timbre_dissonance<VassilakisModel>(
+	std::span<Partial const>,
+	std::span<WeightedInterval const>,
+	std::size_t
+) -> TimbreDissonance;
+
+template auto optimize_timbre<SetharesModel>(
+	std::span<Partial const>,
+	std::span<WeightedInterval const>,
+	TimbreOptimizationSettings const&,
+	std::size_t
+) -> TimbreOptimization;
+template auto optimize_timbre<ProductModel>(
+	std::span<Partial const>,
+	std::span<WeightedInterval const>,
+	TimbreOptimizationSettings const&,
+	std::size_t
+) -> TimbreOptimization;
+template auto optimize_timbre<VassilakisModel>(
+	std::span<Partial const>,
+	std::span<WeightedInterval const>,
+	TimbreOptimizationSettings const&,
+	std::size_t
+) -> TimbreOptimization;
+} // namespace disscalc
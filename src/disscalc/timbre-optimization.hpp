@@ -0,0 +1,148 @@
+#ifndef DISSCALC_TIMBRE_OPTIMIZATION_HPP_INCLUDED
+#define DISSCALC_TIMBRE_OPTIMIZATION_HPP_INCLUDED
+
+#include "disscalc/models.hpp"
+#include "disscalc/partial.hpp"
+#include "disscalc/scales.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace disscalc
+{
+/// Parameters of each partial adjusted when optimizing a timbre.
+enum struct OptimizedParameters
+{
+	frequencies,
+	amplitudes,
+	both,
+};
+
+/// Find the parameters with the given name.
+[[nodiscard]] constexpr
+auto find_optimized_parameters(std::string_view name) noexcept
+	-> std::optional<OptimizedParameters>
+{
+	if (name == "frequencies")
+	{
+		return OptimizedParameters::frequencies;
+	}
+	if (name == "amplitudes")
+	{
+		return OptimizedParameters::amplitudes;
+	}
+	if (name == "both")
+	{
+		return OptimizedParameters::both;
+	}
+	return std::nullopt;
+}
+
+/// Bounds and limits of a timbre optimization.
+struct TimbreOptimizationSettings
+{
+	OptimizedParameters parameters = OptimizedParameters::frequencies;
+
+	/// Greatest distance of each frequency from where it started, in cents.
+	double frequency_range = 50.0;
+
+	/** Greatest factor by which each amplitude may rise or fall.
+	 *
+	 * The sum of the amplitudes is also kept the same, since otherwise every
+	 * amplitude would simply fall as far as it could.
+	 */
+	double amplitude_range = 2.0;
+
+	/// Greatest number of steps taken.
+	std::size_t max_iterations = 100;
+};
+
+/// An interval at which a timbre is evaluated, counted `count` times.
+struct WeightedInterval
+{
+	double interval;
+	double count;
+};
+
+/** Find the interval between each pair of pitches of `scale`.
+ *
+ * Pairs spanning the same interval are counted together, as by
+ * `compute_pair_dissonances`, so the sum of the dissonance at each interval
+ * times its count is the total given by `evaluate_scale`.
+ */
+[[nodiscard]]
+auto find_scale_intervals(Scale const& scale) -> std::vector<WeightedInterval>;
+
+/// Dissonance of a timbre with itself at several intervals, and its gradient.
+struct TimbreDissonance
+{
+	/// Sum of the dissonance at each interval times its count.
+	double total;
+
+	/// Derivative of `total` with respect to the frequency of each partial.
+	std::vector<double> frequency_slopes;
+
+	/// Derivative of `total` with respect to the amplitude of each partial.
+	std::vector<double> amplitude_slopes;
+};
+
+/** Compute the total dissonance of a timbre with itself and its gradient.
+ *
+ * The timbre is used as both the stable and the mobile timbre, so each
+ * partial contributes on both sides of every interval. The derivatives are
+ * those of the kernel of `Model`, found analytically, and where two partials
+ * coincide the kernel has a corner whose slope is taken to be zero. The
+ * slopes of the partials are computed in parallel. Instantiations exist for
+ * every model in `DissonanceModel`.
+ *
+ * @param thread_count the maximum number of threads, as for `parallel_for`.
+ */
+template <DissonanceModelPolicy Model>
+[[nodiscard]]
+auto compute_timbre_dissonance(
+	std::span<Partial const> partials,
+	std::span<WeightedInterval const> intervals,
+	std::size_t thread_count
+) -> TimbreDissonance;
+
+/// Timbre found by `optimize_timbre`, along with how far it improved.
+struct TimbreOptimization
+{
+	std::vector<Partial> partials;
+
+	/// Total dissonance of the starting timbre.
+	double initial_dissonance;
+
+	/// Total dissonance of `partials`.
+	double final_dissonance;
+
+	/// Number of steps taken.
+	std::size_t iterations;
+};
+
+/** Adjust a timbre to minimize its total dissonance at `intervals`.
+ *
+ * The total is that of `compute_timbre_dissonance`. Each step moves against
+ * the gradient, with frequencies moving in proportion to their logarithms,
+ * and tries several lengths of step in parallel, keeping whichever gives the
+ * least dissonance once the timbre is brought back within the bounds of
+ * `settings`. This stops when no step lowers the dissonance or after
+ * `settings.max_iterations` steps. Instantiations exist for every model in
+ * `DissonanceModel`.
+ *
+ * @param thread_count the maximum number of threads, as for `parallel_for`.
+ */
+template <DissonanceModelPolicy Model>
+[[nodiscard]]
+auto optimize_timbre(
+	std::span<Partial const> start,
+	std::span<WeightedInterval const> intervals,
+	TimbreOptimizationSettings const& settings,
+	std::size_t thread_count
+) -> TimbreOptimization;
+} // namespace disscalc
+
+#endif
@@ -0,0 +1,224 @@
+#include "disscalc/wav.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <string_view>
+
+namespace disscalc
+{
+// Tag of integer PCM data in the "fmt " chunk.
+constexpr std::uint16_t pcm_format_tag = 1;
+
+// Tag of IEEE float data in the "fmt " chunk.
+constexpr std::uint16_t float_format_tag = 3;
+
+// Tag indicating that the real tag is in the extension of the "fmt " chunk.
+constexpr std::uint16_t extensible_format_tag = 0xFFFE;
+
+// Decode an unsigned little-endian integer of `size` bytes.
+[[nodiscard]] static
+std::uint64_t decode_little_endian(
+	unsigned char const* bytes,
+	std::size_t size
+) noexcept
+{
+	std::uint64_t result = 0;
+	for (std::size_t i = size; i-- > 0;)
+	{
+		result = (result << 8) | bytes[i];
+	}
+	return result;
+}
+
+// Read a little-endian integer of type `T` from `in`.
+template <typename T>
+[[nodiscard]] static
+bool read_little_endian(std::istream& in, T& value)
+{
+	std::array<unsigned char, sizeof(T)> bytes;
+	if (!in.read(reinterpret_cast<char*>(bytes.data()), sizeof(T)))
+	{
+		return false;
+	}
+	value = static_cast<T>(decode_little_endian(bytes.data(), sizeof(T)));
+	return true;
+}
+
+// Read a four-character chunk identifier.
+[[nodiscard]] static
+bool read_chunk_id(std::istream& in, std::array<char, 4>& id)
+{
+	return static_cast<bool>(in.read(id.data(), id.size()));
+}
+
+[[nodiscard]] static
+bool chunk_id_is(std::array<char, 4> const& id, std::string_view expected)
+{
+	return std::string_view(id.data(), id.size()) == expected;
+}
+
+bool WavReader::read_format_chunk(std::uint32_t size)
+{
+	std::uint16_t format_tag;
+	std::uint32_t byte_rate;
+	std::uint16_t block_align;
+	if (
+		size < 16
+		|| !read_little_endian(in_, format_tag)
+		|| !read_little_endian(in_, format_.channels)
+		|| !read_little_endian(in_, format_.sample_rate)
+		|| !read_little_endian(in_, byte_rate)
+		|| !read_little_endian(in_, block_align)
+		|| !read_little_endian(in_, format_.bits_per_sample)
+	)
+	{
+		return false;
+	}
+	std::uint32_t read_size = 16;
+
+	if (format_tag == extensible_format_tag && size >= 40)
+	{
+		// Size, valid bits and channel mask precede the sub-format tag.
+		std::array<char, 8> skipped;
+		if (
+			!in_.read(skipped.data(), skipped.size())
+			|| !read_little_endian(in_, format_tag)
+		)
+		{
+			return false;
+		}
+		read_size += static_cast<std::uint32_t>(skipped.size()) + 2;
+	}
+
+	// Skip the rest of the chunk, including its padding byte.
+	in_.ignore(size - read_size + (size & 1));
+
+	format_.is_float = format_tag == float_format_tag;
+	bool const supported_integer = format_tag == pcm_format_tag
+		&& (format_.bits_per_sample == 8
+			|| format_.bits_per_sample == 16
+			|| format_.bits_per_sample == 24
+			|| format_.bits_per_sample == 32);
+	bool const supported_float = format_.is_float
+		&& (format_.bits_per_sample == 32 || format_.bits_per_sample == 64);
+
+	return static_cast<bool>(in_)
+		&& format_.channels > 0
+		&& format_.sample_rate > 0
+		&& (supported_integer || supported_float);
+}
+
+WavReader::WavReader(std::istream& in)
+	: in_(in)
+{
+	std::array<char, 4> id;
+	std::uint32_t size;
+	if (
+		!read_chunk_id(in_, id)
+		|| !chunk_id_is(id, "RIFF")
+		|| !read_little_endian(in_, size)
+		|| !read_chunk_id(in_, id)
+		|| !chunk_id_is(id, "WAVE")
+	)
+	{
+		return;
+	}
+
+	bool has_format = false;
+	while (read_chunk_id(in_, id) && read_little_endian(in_, size))
+	{
+		if (chunk_id_is(id, "fmt "))
+		{
+			if (!read_format_chunk(size))
+			{
+				return;
+			}
+			has_format = true;
+		}
+		else if (chunk_id_is(id, "data"))
+		{
+			// Sample data must come after the format.
+			valid_ = has_format;
+			remaining_bytes_ = size;
+			return;
+		}
+		else
+		{
+			in_.ignore(size + (size & 1));
+		}
+	}
+}
+
+[[nodiscard]]
+double WavReader::decode_sample(unsigned char const* bytes) const noexcept
+{
+	auto const bytes_per_sample =
+		static_cast<std::size_t>(format_.bits_per_sample / 8);
+	auto const raw = decode_little_endian(bytes, bytes_per_sample);
+
+	if (format_.is_float)
+	{
+		if (bytes_per_sample == 4)
+		{
+			return std::bit_cast<float>(static_cast<std::uint32_t>(raw));
+		}
+		return std::bit_cast<double>(raw);
+	}
+
+	// 8-bit samples are unsigned, and the rest are two's complement.
+	if (bytes_per_sample == 1)
+	{
+		return (static_cast<double>(raw) - 128.0) / 128.0;
+	}
+
+	auto const bits = format_.bits_per_sample;
+	auto const sign_bit = std::uint64_t(1) << (bits - 1);
+	auto const value = static_cast<double>(
+		static_cast<std::int64_t>(raw ^ sign_bit)
+		- static_cast<std::int64_t>(sign_bit)
+	);
+	return value / static_cast<double>(sign_bit);
+}
+
+[[nodiscard]]
+std::size_t WavReader::read_mono(std::span<double> out)
+{
+	auto const bytes_per_sample =
+		static_cast<std::size_t>(format_.bits_per_sample / 8);
+	auto const bytes_per_frame = bytes_per_sample * format_.channels;
+
+	auto const frames = std::min<std::uint64_t>(
+		out.size(),
+		remaining_bytes_ / bytes_per_frame
+	);
+	buffer_.resize(static_cast<std::size_t>(frames) * bytes_per_frame);
+
+	in_.read(
+		reinterpret_cast<char*>(buffer_.data()),
+		static_cast<std::streamsize>(buffer_.size())
+	);
+	auto const frames_read =
+		static_cast<std::size_t>(in_.gcount()) / bytes_per_frame;
+	remaining_bytes_ = frames_read == frames
+		? remaining_bytes_ - buffer_.size()
+		: 0;
+
+	for (std::size_t frame = 0; frame < frames_read; ++frame)
+	{
+		double sum = 0.0;
+		for (std::size_t channel = 0; channel < format_.channels; ++channel)
+		{
+			sum += decode_sample(
+				buffer_.data()
+				+ frame * bytes_per_frame
+				+ channel * bytes_per_sample
+			);
+		}
+		out[frame] = sum / format_.channels;
+	}
+
+	return frames_read;
+}
+} // namespace disscalc
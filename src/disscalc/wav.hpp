@@ -0,0 +1,85 @@
+#ifndef DISSCALC_WAV_HPP_INCLUDED
+#define DISSCALC_WAV_HPP_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <vector>
+
+namespace disscalc
+{
+/// Layout of the samples in a WAV file.
+struct WavFormat
+{
+	std::uint16_t channels;
+	std::uint32_t sample_rate;
+	std::uint16_t bits_per_sample;
+
+	/// Whether samples are IEEE floats rather than integers.
+	bool is_float;
+};
+
+/** Streaming reader for PCM WAV files.
+ *
+ * Integer samples of 8, 16, 24 or 32 bits and float samples of 32 or 64 bits
+ * are supported. Only a small block of the file is held in memory at a time,
+ * so files of any length can be read.
+ */
+class WavReader
+{
+public:
+	/** Read the header of a WAV file from `in`.
+	 *
+	 * `in` must be opened in binary mode and outlive this reader. After
+	 * construction, `in` is positioned at the start of the sample data.
+	 */
+	explicit WavReader(std::istream& in);
+
+	/** Indicate whether the header was read successfully.
+	 *
+	 * If not, no other member functions can safely be called.
+	 */
+	[[nodiscard]]
+	bool is_valid(void) const noexcept
+	{
+		return valid_;
+	}
+
+	[[nodiscard]]
+	auto format(void) const noexcept -> WavFormat const&
+	{
+		return format_;
+	}
+
+	/** Read up to `out.size()` frames, mixing all channels down to mono.
+	 *
+	 * Samples are scaled to the range [-1, 1].
+	 *
+	 * @return the number of frames read, which is only less than
+	 * `out.size()` at the end of the data.
+	 */
+	[[nodiscard]]
+	std::size_t read_mono(std::span<double> out);
+
+private:
+	// Read the "fmt " chunk of the given size.
+	[[nodiscard]]
+	bool read_format_chunk(std::uint32_t size);
+
+	// Decode the sample starting at `bytes` into the range [-1, 1].
+	[[nodiscard]]
+	double decode_sample(unsigned char const* bytes) const noexcept;
+
+	std::istream& in_;
+	WavFormat format_{};
+	bool valid_ = false;
+
+	// Bytes of sample data not yet read.
+	std::uint64_t remaining_bytes_ = 0;
+
+	std::vector<unsigned char> buffer_;
+};
+} // namespace disscalc
+
+#endif
@@ -1,66 +1,1215 @@
+#include "disscalc/blocked-engine.hpp"
+#include "disscalc/bounded-queue.hpp"
+#include "disscalc/chebyshev-curve.hpp"
+#include "disscalc/checkpoint.hpp"
+#include "disscalc/chords.hpp"
+#include "disscalc/code-generation.hpp"
+#include "disscalc/decimation.hpp"
 #include "disscalc/dissonance.hpp"
+#include "disscalc/engine.hpp"
+#include "disscalc/extra-values.hpp"
+#include "disscalc/fft-engine.hpp"
+#include "disscalc/frames.hpp"
 #include "disscalc/options.hpp"
 #include "disscalc/output.hpp"
+#include "disscalc/parallel.hpp"
+#include "disscalc/scales.hpp"
 #include "disscalc/table.hpp"
+#include "disscalc/timbre-extraction.hpp"
+#include "disscalc/timbre-family.hpp"
+#include "disscalc/timbre-optimization.hpp"
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <iterator>
+#include <optional>
+#include <random>
+#include <span>
 #include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+ * Call `write(out)` with the output stream selected by the options. Return
+ * false on failure.
+ */
+static
+bool write_output(
+	disscalc::ProgramOptions const& options,
+	std::invocable<std::ostream&> auto write,
+	std::ios::openmode mode = std::ios::out
+)
+{
+	if (!options.output_file_name().has_value())
+	{
+		write(std::cout);
+		return true;
+	}
+
+	// Must be converted to std::string to be compatible with std::ofstream.
+	std::ofstream output_file(std::string(*options.output_file_name()), mode);
+	if (!output_file)
+	{
+		disscalc::print_generic_error(
+			std::cerr,
+			"Could not open output file"
+		);
+		return false;
+	}
+
+	write(output_file);
+	return true;
+}
+
+// Partials of both notes of each interval.
+struct Timbres
+{
+	std::vector<disscalc::Partial> stable;
+	std::vector<disscalc::Partial> mobile;
+};
+
+/*
+ * Get the timbres given by the options, reading them from files if necessary.
+ * Return an empty optional on failure.
+ */
+[[nodiscard]] static
+auto load_timbres(disscalc::ProgramOptions const& options)
+	-> std::optional<Timbres>
+{
+	Timbres timbres;
+
+	if (auto const wav_file_name = options.timbre_wav_file())
+	{
+		std::ifstream wav_file(std::string(*wav_file_name), std::ios::binary);
+		auto partials = disscalc::extract_timbre_from_wav(
+			wav_file,
+			options.fft_size(),
+			options.peak_settings()
+		);
+		if (!partials.has_value())
+		{
+			disscalc::print_generic_error(
+				std::cerr,
+				"Could not read WAV file: " + std::string(*wav_file_name)
+			);
+			return std::nullopt;
+		}
+		timbres.stable = std::move(*partials);
+	}
+	else
+	{
+		timbres.stable = options.stable_partials();
+	}
+
+	timbres.mobile = options.has_mobile_partials()
+		? options.mobile_partials()
+		: timbres.stable;
+
+	return timbres;
+}
+
+/*
+ * Add the extra intervals of the file given by the options, if any, to the
+ * others. Return false on failure.
+ */
+[[nodiscard]] static
+bool load_extra_values(disscalc::ProgramOptions& options)
+{
+	auto const extra_file_name = options.extra_file();
+	if (!extra_file_name.has_value())
+	{
+		return true;
+	}
+
+	std::ifstream extra_file(std::string(*extra_file_name), std::ios::binary);
+	if (!extra_file)
+	{
+		disscalc::print_generic_error(
+			std::cerr,
+			"Could not open extra interval file"
+		);
+		return false;
+	}
+
+	auto list = disscalc::read_extra_values(extra_file);
+	if (auto const position = list.error_position)
+	{
+		disscalc::print_generic_error(
+			std::cerr,
+			"Malformed extra interval file at line or value "
+				+ std::to_string(*position)
+		);
+		return false;
+	}
+	options.add_extra_values(std::move(list.values));
+	return true;
+}
+
+/*
+ * If requested, reduce the partials of `timbres` so that the dissonance of any
+ * interval within `intervals` changes by no more than the maximum error, and
+ * report the reduction.
+ */
+static
+void reduce_timbres(
+	disscalc::ProgramOptions const& options,
+	Timbres& timbres,
+	disscalc::IntervalBounds intervals,
+	disscalc::DissonanceModelPolicy auto model
+)
+{
+	using Model = decltype(model);
+
+	if (!options.max_error().has_value())
+	{
+		return;
+	}
+
+	auto const report = disscalc::reduce_partials<Model>(
+		timbres.stable,
+		timbres.mobile,
+		!options.has_mobile_partials(),
+		intervals,
+		*options.max_error()
+	);
+	disscalc::print_reduction_report(std::cerr, report);
+}
+
+/*
+ * Output the rows of the table within `rows` to the output file, resuming from
+ * the checkpoint file if it exists and periodically recording progress there.
+ * Return false on failure.
+ */
+static
+bool output_checkpointed_table(
+	disscalc::ProgramOptions const& options,
+	std::uint64_t fingerprint,
+	disscalc::RowRange rows,
+	std::invocable<double> auto compute_this_dissonance
+)
+{
+	namespace fs = std::filesystem;
+
+	fs::path const output_path(*options.output_file_name());
+	fs::path const checkpoint_path(*options.checkpoint_file());
+
+	disscalc::Checkpoint progress{fingerprint, 0, 0};
+	std::error_code error;
+	if (fs::exists(checkpoint_path))
+	{
+		std::ifstream checkpoint_file(checkpoint_path);
+		auto const saved = disscalc::read_checkpoint(checkpoint_file);
+		if (!saved.has_value() || saved->fingerprint != fingerprint)
+		{
+			disscalc::print_generic_error(
+				std::cerr,
+				"Checkpoint file does not match these options and inputs"
+			);
+			return false;
+		}
+		progress = *saved;
+
+		// Discard anything written after the checkpoint was saved.
+		auto const output_size = fs::file_size(output_path, error);
+		if (error || output_size < progress.output_size)
+		{
+			disscalc::print_generic_error(
+				std::cerr,
+				"Output file is shorter than its checkpoint"
+			);
+			return false;
+		}
+		fs::resize_file(output_path, progress.output_size, error);
+	}
+	else
+	{
+		std::ofstream truncated(output_path, std::ios::trunc);
+		error = truncated
+			? std::error_code()
+			: std::make_error_code(std::errc::io_error);
+	}
+
+	std::ofstream output_file(output_path, std::ios::app);
+	if (error || !output_file)
+	{
+		disscalc::print_generic_error(
+			std::cerr,
+			"Could not open output file"
+		);
+		return false;
+	}
+
+	using Clock = std::chrono::steady_clock;
+	auto const interval = std::chrono::duration<double>(
+		options.checkpoint_interval()
+	);
+	auto last_save = Clock::now();
+	bool saved_all = true;
+
+	auto const save = [&](std::size_t completed_rows)
+	{
+		output_file.flush();
+		progress.completed_rows = completed_rows;
+		progress.output_size = fs::file_size(output_path, error);
+		saved_all = saved_all
+			&& output_file
+			&& !error
+			&& disscalc::save_checkpoint(checkpoint_path, progress);
+		last_save = Clock::now();
+	};
+
+	disscalc::print_table_as_dsv(
+		output_file,
+		options.start(),
+		options.delta(),
+		options.end(),
+		compute_this_dissonance,
+		options.delimiter(),
+		options.extra_values(),
+		{rows.first + progress.completed_rows, rows.last},
+		[&](std::size_t row)
+		{
+			if (Clock::now() - last_save >= interval)
+			{
+				save(row + 1 - rows.first);
+			}
+		}
+	);
+
+	output_file.flush();
+	if (!output_file || !saved_all)
+	{
+		disscalc::print_generic_error(
+			std::cerr,
+			"Could not record progress of the output"
+		);
+		return false;
+	}
+
+	// The table is complete, so there is nothing left to resume.
+	fs::remove(checkpoint_path, error);
+	return true;
+}
+
+// Get the inputs of the table given by the options.
+[[nodiscard]] static
+auto make_interval_grid(disscalc::ProgramOptions const& options)
+	-> disscalc::IntervalGrid
+{
+	return {
+		options.start(),
+		options.delta(),
+		options.end(),
+		options.extra_values()
+	};
+}
+
+// Get the input of every row of the table.
+[[nodiscard]] static
+auto collect_table_inputs(disscalc::ProgramOptions const& options)
+	-> std::vector<double>
+{
+	auto const grid = make_interval_grid(options);
+	std::vector<double> intervals;
+	intervals.reserve(grid.size());
+	for (auto const input : grid)
+	{
+		intervals.push_back(input.value);
+	}
+	return intervals;
+}
+
+/*
+ * Output a table whose rows were all computed beforehand. Return false on
+ * failure.
+ */
+static
+bool write_table_rows(
+	disscalc::ProgramOptions const& options,
+	std::span<double const> intervals,
+	std::span<double const> dissonances
+)
+{
+	return write_output(options, [&](std::ostream& out)
+	{
+		for (std::size_t i = 0; i < intervals.size(); ++i)
+		{
+			disscalc::print_table_entry(
+				out,
+				intervals[i],
+				dissonances[i],
+				options.delimiter()
+			);
+		}
+	});
+}
+
+/*
+ * Greatest number of pairs of partials used to measure the error of the FFT
+ * engine, over every interval at which it is measured.
+ */
+constexpr std::size_t fft_error_check_pairs = 100'000'000;
+
+// Greatest number of intervals used to measure the error of the FFT engine.
+constexpr std::size_t fft_error_check_intervals = 8;
+
+/*
+ * Number of intervals at which the error of the FFT engine is estimated when
+ * the timbres are too large to measure it with every partial.
+ */
+constexpr std::size_t fft_error_estimate_intervals = 2;
+
+// Seed choosing the partials used to estimate the error of the FFT engine.
+constexpr std::mt19937::result_type fft_error_seed = 1;
+
+/*
+ * Estimate the error of the FFT engine at a few of `intervals` by comparing it
+ * with the exact dissonance for a random subset of the stable partials, small
+ * enough for the comparison to be cheap.
+ */
+template <disscalc::DissonanceModelPolicy Model>
+[[nodiscard]] static
+auto estimate_fft_error(
+	Timbres const& timbres,
+	std::span<double const> intervals
+) -> disscalc::EngineError
+{
+	auto const sample_count = std::min(
+		fft_error_estimate_intervals,
+		intervals.size()
+	);
+	std::vector<double> sample_intervals;
+	for (std::size_t i = 0; i < sample_count; ++i)
+	{
+		sample_intervals.push_back(
+			intervals[
+				sample_count == 1
+					? intervals.size() / 2
+					: i * (intervals.size() - 1) / (sample_count - 1)
+			]
+		);
+	}
+
+	auto const subset_size = std::clamp<std::size_t>(
+		fft_error_check_pairs / fft_error_estimate_intervals
+			/ std::max<std::size_t>(timbres.mobile.size(), 1),
+		1,
+		timbres.stable.size()
+	);
+	std::vector<disscalc::Partial> stable_subset;
+	std::ranges::sample(
+		timbres.stable,
+		std::back_inserter(stable_subset),
+		static_cast<std::ptrdiff_t>(subset_size),
+		std::mt19937(fft_error_seed)
+	);
+
+	auto const approximate = disscalc::compute_dissonance_curve_fft<Model>(
+		stable_subset,
+		timbres.mobile,
+		sample_intervals
+	);
+	auto error = disscalc::measure_engine_error(
+		sample_intervals,
+		approximate,
+		sample_count,
+		[&](double x) noexcept
+		{
+			return disscalc::compute_dissonance<Model>(
+				stable_subset,
+				timbres.mobile,
+				x
+			);
+		}
+	);
+	error.sampled_partials = stable_subset.size();
+	return error;
+}
+
+/*
+ * Output the whole table computed by the FFT engine, then report its error at
+ * a sample of the intervals on standard error. Return false on failure.
+ */
+static
+bool output_fft_table(
+	disscalc::ProgramOptions const& options,
+	Timbres const& timbres,
+	disscalc::DissonanceModelPolicy auto model
+)
+{
+	using Model = decltype(model);
+
+	auto const intervals = collect_table_inputs(options);
+
+	auto const dissonances = disscalc::compute_dissonance_curve_fft<Model>(
+		timbres.stable,
+		timbres.mobile,
+		intervals
+	);
+
+	bool const written = write_table_rows(options, intervals, dissonances);
+
+	auto const pairs = std::max<std::size_t>(
+		timbres.stable.size() * timbres.mobile.size(),
+		1
+	);
+	auto const check_count = std::min(
+		fft_error_check_intervals,
+		fft_error_check_pairs / pairs
+	);
+	auto const error = check_count >= fft_error_estimate_intervals
+		? disscalc::measure_engine_error(
+			intervals,
+			dissonances,
+			check_count,
+			[&](double x) noexcept
+			{
+				return disscalc::compute_dissonance<Model>(
+					timbres.stable,
+					timbres.mobile,
+					x
+				);
+			}
+		)
+		: estimate_fft_error<Model>(timbres, intervals);
+	disscalc::print_engine_error(std::cerr, error);
+
+	return written;
+}
+
+/*
+ * Output every row of the table in progressively finer levels, tagging each
+ * row with its level and flushing the output after each level. Return false
+ * on failure.
+ */
+static
+bool output_progressive_table(
+	disscalc::ProgramOptions const& options,
+	std::invocable<double> auto compute_this_dissonance
+)
+{
+	auto const grid = make_interval_grid(options);
+	std::vector<double> dissonances(grid.size());
+
+	return write_output(options, [&](std::ostream& out)
+	{
+		disscalc::for_each_progressive_level(
+			grid.size(),
+			[&](std::size_t level, std::span<std::size_t const> rows)
+			{
+				disscalc::parallel_for(
+					rows.size(),
+					options.thread_count(),
+					[&](std::size_t i)
+						noexcept(
+							std::is_nothrow_invocable_v<
+								decltype(compute_this_dissonance)&,
+								double
+							>
+						)
+					{
+						dissonances[rows[i]]
+							= compute_this_dissonance(grid[rows[i]].value);
+					}
+				);
+
+				for (auto const row : rows)
+				{
+					disscalc::print_progressive_table_entry(
+						out,
+						level,
+						grid[row].value,
+						dissonances[row],
+						options.delimiter()
+					);
+				}
+				out.flush();
+			}
+		);
+	});
+}
 
 // Output the data based on the options given. Return false on failure.
 static
-bool output_table(disscalc::ProgramOptions const& options)
+bool output_table(
+	disscalc::ProgramOptions const& options,
+	std::uint64_t fingerprint,
+	Timbres timbres,
+	disscalc::DissonanceModelPolicy auto model
+)
 {
-	auto const stable_partials = options.stable_partials();
-	auto const mobile_partials = options.mobile_partials();
+	using Model = decltype(model);
+
+	auto const& extra_values = options.extra_values();
+	reduce_timbres(
+		options,
+		timbres,
+		{
+			extra_values.empty()
+				? options.start()
+				: std::min(options.start(), *std::begin(extra_values)),
+			extra_values.empty()
+				? options.end()
+				: std::max(options.end(), *std::rbegin(extra_values))
+		},
+		model
+	);
+
+	if constexpr (disscalc::has_fft_engine<Model>)
+	{
+		if (options.engine() == disscalc::Engine::fft)
+		{
+			return output_fft_table(options, timbres, model);
+		}
+	}
+
+	if (options.engine() == disscalc::Engine::blocked)
+	{
+		auto const intervals = collect_table_inputs(options);
+		std::vector<double> dissonances(intervals.size());
+		disscalc::compute_dissonance_curve_blocked<Model>(
+			timbres.stable,
+			timbres.mobile,
+			intervals,
+			dissonances,
+			options.thread_count()
+		);
+		return write_table_rows(options, intervals, dissonances);
+	}
+
+	auto const& stable_partials = timbres.stable;
+	auto const& mobile_partials = timbres.mobile;
 	char const separator = options.delimiter();
 
 	auto const compute_this_dissonance = [&](double d) noexcept
 	{
-		return disscalc::compute_dissonance(
+		return disscalc::compute_dissonance<Model>(
 			stable_partials,
 			mobile_partials,
 			d
 		);
 	};
 
-	if (!options.output_file_name().has_value())
+	if (options.is_progressive())
+	{
+		return output_progressive_table(options, compute_this_dissonance);
+	}
+
+	if (options.writes_chebyshev())
+	{
+		auto const curve = disscalc::fit_chebyshev_curve(
+			options.start(),
+			options.end(),
+			options.curve_tolerance(),
+			options.curve_degree(),
+			compute_this_dissonance
+		);
+		if (!(curve.error_bound() <= options.curve_tolerance()))
+		{
+			disscalc::print_generic_error(
+				std::cerr,
+				"Could not fit a chebyshev curve within the tolerance"
+			);
+			return false;
+		}
+		return write_output(
+			options,
+			[&](std::ostream& out)
+			{
+				disscalc::write_chebyshev_curve(out, curve);
+			},
+			std::ios::out | std::ios::binary
+		);
+	}
+
+	auto rows = disscalc::all_rows;
+	if (auto const shard = options.shard())
+	{
+		rows = disscalc::get_shard_rows(
+			make_interval_grid(options).size(),
+			shard->index,
+			shard->count
+		);
+	}
+
+	if (options.writes_cpp())
+	{
+		// The header needs the number of rows before any of them.
+		std::vector<disscalc::TableRow> kept_rows;
+		auto const keep_row = [&](disscalc::TableRow const& row)
+		{
+			kept_rows.push_back(row);
+		};
+		std::optional<disscalc::Decimator<decltype(keep_row)>> decimator;
+		if (auto const tolerance = options.decimation_tolerance())
+		{
+			decimator.emplace(*tolerance, keep_row);
+		}
+
+		disscalc::for_each_table_row(
+			options.start(),
+			options.delta(),
+			options.end(),
+			compute_this_dissonance,
+			options.extra_values(),
+			rows,
+			[&](std::size_t, disscalc::TableRow const& row)
+			{
+				if (decimator.has_value())
+				{
+					decimator->add(row);
+				}
+				else
+				{
+					keep_row(row);
+				}
+			}
+		);
+		if (decimator.has_value())
+		{
+			decimator->finish();
+		}
+
+		if (kept_rows.empty())
+		{
+			disscalc::print_generic_error(
+				std::cerr,
+				"A C++ header cannot hold an empty table"
+			);
+			return false;
+		}
+		return write_output(options, [&](std::ostream& out)
+		{
+			disscalc::write_table_as_cpp(
+				out,
+				kept_rows,
+				options.cpp_header_settings()
+			);
+		});
+	}
+
+	if (auto const tolerance = options.decimation_tolerance())
+	{
+		return write_output(options, [&](std::ostream& out)
+		{
+			disscalc::Decimator decimator(
+				*tolerance,
+				[&](disscalc::TableRow const& row)
+				{
+					disscalc::print_table_entry(
+						out,
+						row.input,
+						row.output,
+						separator
+					);
+				}
+			);
+			disscalc::for_each_table_row(
+				options.start(),
+				options.delta(),
+				options.end(),
+				compute_this_dissonance,
+				options.extra_values(),
+				rows,
+				[&](std::size_t, disscalc::TableRow const& row)
+				{
+					decimator.add(row);
+				}
+			);
+			decimator.finish();
+		});
+	}
+
+	if (options.checkpoint_file().has_value())
+	{
+		return output_checkpointed_table(
+			options,
+			fingerprint,
+			rows,
+			compute_this_dissonance
+		);
+	}
+
+	return write_output(options, [&](std::ostream& out)
 	{
 		disscalc::print_table_as_dsv(
-			std::cout,
+			out,
 			options.start(),
 			options.delta(),
 			options.end(),
 			compute_this_dissonance,
 			separator,
-			options.extra_values()
+			options.extra_values(),
+			rows,
+			[](std::size_t) noexcept {}
 		);
-		return true;
+	});
+}
+
+/*
+ * Output the curve of each frame of the time-varying timbre given in the
+ * options, reading frames as they are needed. Return false on failure.
+ */
+static
+bool output_frames(
+	disscalc::ProgramOptions const& options,
+	Timbres const& timbres,
+	disscalc::DissonanceModelPolicy auto model
+)
+{
+	using Model = decltype(model);
+
+	std::ifstream frames_file;
+	std::istream* frames_in = &std::cin;
+	if (*options.frames_file() != "-")
+	{
+		frames_file.open(std::string(*options.frames_file()));
+		if (!frames_file)
+		{
+			disscalc::print_generic_error(
+				std::cerr,
+				"Could not open frames file"
+			);
+			return false;
+		}
+		frames_in = &frames_file;
 	}
 
-	// Must be converted to std::string to be compatible with std::ofstream.
-	std::ofstream output_file(std::string(*options.output_file_name()));
-	if (!output_file)
+	// The inputs are the same for every frame, so only outputs are recomputed.
+	std::vector<disscalc::TableRow> rows;
+	for (auto const input : make_interval_grid(options))
+	{
+		rows.push_back({input.value, 0.0, input.is_extra});
+	}
+
+	disscalc::TimbreFrameReader reader(*frames_in);
+	disscalc::BoundedQueue<disscalc::TimbreFrame> frames(4);
+
+	// Parse upcoming frames while the current one is computed.
+	std::jthread reading_thread([&]
+	{
+		while (auto frame = reader.next())
+		{
+			if (!frames.push(std::move(*frame)))
+			{
+				break;
+			}
+		}
+		frames.close();
+	});
+
+	char const separator = options.delimiter();
+	auto const summary = options.frame_summary();
+	std::vector<disscalc::Partial> curve_timbre;
+	bool has_curve = false;
+
+	bool const wrote = write_output(options, [&](std::ostream& out)
+	{
+		while (auto frame = frames.pop())
+		{
+			if (
+				!has_curve
+				|| !disscalc::timbres_are_similar(
+					frame->partials,
+					curve_timbre,
+					options.frame_tolerance()
+				)
+			)
+			{
+				auto const& mobile_partials = options.has_mobile_partials()
+					? timbres.mobile
+					: frame->partials;
+				disscalc::parallel_for(
+					rows.size(),
+					options.thread_count(),
+					[&](std::size_t i) noexcept
+					{
+						rows[i].output = disscalc::compute_dissonance<Model>(
+							frame->partials,
+							mobile_partials,
+							rows[i].input
+						);
+					}
+				);
+				curve_timbre = std::move(frame->partials);
+				has_curve = true;
+			}
+
+			if (summary == disscalc::FrameSummary::minima)
+			{
+				disscalc::print_frame_rows(
+					out,
+					frame->index,
+					disscalc::find_local_minima(rows),
+					separator
+				);
+			}
+			else
+			{
+				disscalc::print_frame_rows(out, frame->index, rows, separator);
+			}
+		}
+	});
+
+	// Let the reading thread finish if output stopped early.
+	frames.close();
+	reading_thread.join();
+
+	if (auto const line = reader.error_line())
 	{
 		disscalc::print_generic_error(
 			std::cerr,
-			"Could not open output file"
+			"Malformed frame on line " + std::to_string(*line)
 		);
 		return false;
 	}
+	return wrote;
+}
 
-	disscalc::print_table_as_dsv(
-		output_file,
-		options.start(),
-		options.delta(),
-		options.end(),
-		compute_this_dissonance,
-		separator,
-		options.extra_values()
+/*
+ * Output the dissonance of each timbre of the family given by the sweep in the
+ * options at each interval of the table. Return false on failure.
+ */
+static
+bool output_sweep(
+	disscalc::ProgramOptions const& options,
+	Timbres const& timbres,
+	disscalc::DissonanceModelPolicy auto model
+)
+{
+	using Model = decltype(model);
+
+	auto intervals = collect_table_inputs(options);
+
+	auto const matrix = disscalc::compute_timbre_family(
+		timbres.stable,
+		options.has_mobile_partials()
+			? std::span<disscalc::Partial const>(timbres.mobile)
+			: std::span<disscalc::Partial const>(),
+		*options.sweep(),
+		std::move(intervals),
+		options.thread_count(),
+		[](auto const& stable, auto const& mobile, double d) noexcept
+		{
+			return disscalc::compute_dissonance<Model>(stable, mobile, d);
+		}
 	);
-	return true;
+
+	if (options.writes_binary())
+	{
+		return write_output(
+			options,
+			[&](std::ostream& out)
+			{
+				disscalc::write_matrix_as_binary(out, matrix);
+			},
+			std::ios::out | std::ios::binary
+		);
+	}
+	return write_output(options, [&](std::ostream& out)
+	{
+		disscalc::print_matrix_as_dsv(out, matrix, options.delimiter());
+	});
+}
+
+/*
+ * Load every scale requested by the options, EDOs first. Return an empty
+ * optional on failure.
+ */
+[[nodiscard]] static
+auto load_scales(disscalc::ProgramOptions const& options)
+	-> std::optional<std::vector<disscalc::Scale>>
+{
+	std::vector<disscalc::Scale> scales;
+
+	if (auto const edos = options.edo_range())
+	{
+		for (auto divisions = edos->first; divisions <= edos->last; ++divisions)
+		{
+			scales.push_back(disscalc::make_edo_scale(divisions));
+		}
+	}
+
+	for (auto const file_name : options.scale_files())
+	{
+		std::ifstream scale_file{std::string(file_name)};
+		auto scale = disscalc::read_scala_scale(
+			scale_file,
+			std::string(file_name)
+		);
+		if (!scale.has_value())
+		{
+			disscalc::print_generic_error(
+				std::cerr,
+				"Could not read scale file: " + std::string(file_name)
+			);
+			return std::nullopt;
+		}
+		scales.push_back(std::move(*scale));
+	}
+
+	return scales;
+}
+
+/*
+ * Output the evaluation of each scale given in the options. Return false on
+ * failure.
+ */
+static
+bool output_scales(
+	disscalc::ProgramOptions const& options,
+	Timbres timbres,
+	disscalc::DissonanceModelPolicy auto model
+)
+{
+	using Model = decltype(model);
+
+	auto const scales = load_scales(options);
+	if (!scales.has_value())
+	{
+		return false;
+	}
+
+	// Pairs are always evaluated as the higher pitch over the lower one.
+	double greatest_interval = 1.0;
+	for (auto const& scale : *scales)
+	{
+		auto const [least, greatest] = std::ranges::minmax(scale.pitches);
+		greatest_interval = std::max(greatest_interval, greatest / least);
+	}
+	reduce_timbres(options, timbres, {1.0, greatest_interval}, model);
+
+	auto const& stable_partials = timbres.stable;
+	auto const& mobile_partials = timbres.mobile;
+	char const separator = options.delimiter();
+
+	auto const compute_this_dissonance = [&](double d) noexcept
+	{
+		return disscalc::compute_dissonance<Model>(
+			stable_partials,
+			mobile_partials,
+			d
+		);
+	};
+
+	std::vector<disscalc::ScaleEvaluation> evaluations(scales->size());
+	disscalc::parallel_for(
+		scales->size(),
+		options.thread_count(),
+		[&](std::size_t i)
+		{
+			evaluations[i] = disscalc::evaluate_scale(
+				(*scales)[i],
+				compute_this_dissonance,
+				options.chord_size()
+			);
+		}
+	);
+
+	return write_output(options, [&](std::ostream& out)
+	{
+		for (std::size_t i = 0; i < scales->size(); ++i)
+		{
+			disscalc::print_scale_evaluation(
+				out,
+				(*scales)[i],
+				evaluations[i],
+				separator
+			);
+		}
+	});
+}
+
+/*
+ * Output the stable timbre adjusted to minimize the total dissonance of the
+ * scale given in the options, and report the improvement. Return false on
+ * failure.
+ */
+static
+bool output_optimized_timbre(
+	disscalc::ProgramOptions const& options,
+	Timbres const& timbres,
+	disscalc::DissonanceModelPolicy auto model
+)
+{
+	using Model = decltype(model);
+
+	auto const scales = load_scales(options);
+	if (!scales.has_value())
+	{
+		return false;
+	}
+	auto const intervals = disscalc::find_scale_intervals(scales->front());
+
+	auto const optimization = disscalc::optimize_timbre<Model>(
+		timbres.stable,
+		intervals,
+		options.optimization_settings(),
+		options.thread_count()
+	);
+	disscalc::print_optimization_report(std::cerr, optimization);
+
+	return write_output(options, [&](std::ostream& out)
+	{
+		disscalc::print_timbre_options(out, optimization.partials);
+	});
+}
+
+/*
+ * Output a table with a column for each of the mobile timbres in the file
+ * given in the options. Return false on failure.
+ */
+static
+bool output_wide_table(
+	disscalc::ProgramOptions const& options,
+	Timbres const& timbres,
+	disscalc::DissonanceModelPolicy auto model
+)
+{
+	using Model = decltype(model);
+
+	std::ifstream timbres_file{std::string(*options.mobile_timbres_file())};
+	if (!timbres_file)
+	{
+		disscalc::print_generic_error(
+			std::cerr,
+			"Could not open mobile timbres file"
+		);
+		return false;
+	}
+
+	std::vector<std::vector<disscalc::Partial>> mobile_timbres;
+	disscalc::TimbreFrameReader reader(timbres_file);
+	while (auto timbre = reader.next())
+	{
+		mobile_timbres.push_back(std::move(timbre->partials));
+	}
+	if (auto const line = reader.error_line())
+	{
+		disscalc::print_generic_error(
+			std::cerr,
+			"Malformed timbre on line " + std::to_string(*line)
+		);
+		return false;
+	}
+	if (mobile_timbres.empty())
+	{
+		disscalc::print_generic_error(
+			std::cerr,
+			"Mobile timbres file holds no timbres"
+		);
+		return false;
+	}
+
+	char const separator = options.delimiter();
+	std::vector<double> dissonances(mobile_timbres.size());
+
+	return write_output(options, [&](std::ostream& out)
+	{
+		for (auto const input : make_interval_grid(options))
+		{
+			disscalc::compute_dissonances<Model>(
+				timbres.stable,
+				mobile_timbres,
+				input.value,
+				dissonances
+			);
+			disscalc::print_wide_table_entry(
+				out,
+				input.value,
+				dissonances,
+				separator
+			);
+		}
+	});
+}
+
+/*
+ * Output the dissonance of each chord in the chord file given in the options.
+ * Return false on failure.
+ */
+static
+bool output_chords(
+	disscalc::ProgramOptions const& options,
+	Timbres timbres,
+	disscalc::DissonanceModelPolicy auto model
+)
+{
+	using Model = decltype(model);
+
+	std::ifstream chords_file{std::string(*options.chords_file())};
+	if (!chords_file)
+	{
+		disscalc::print_generic_error(
+			std::cerr,
+			"Could not open chords file"
+		);
+		return false;
+	}
+
+	auto const list = disscalc::read_chords(chords_file);
+	if (auto const line = list.error_line)
+	{
+		disscalc::print_generic_error(
+			std::cerr,
+			"Malformed chord on line " + std::to_string(*line)
+		);
+		return false;
+	}
+	auto const& chords = list.chords;
+
+	double greatest_interval = 1.0;
+	for (auto const& chord : chords)
+	{
+		auto const [least, greatest] = std::ranges::minmax(
+			chord.pitches,
+			{},
+			&disscalc::ChordPitch::ratio
+		);
+		greatest_interval = std::max(
+			greatest_interval,
+			greatest.ratio / least.ratio
+		);
+	}
+	reduce_timbres(options, timbres, {1.0, greatest_interval}, model);
+
+	auto const& stable_partials = timbres.stable;
+	auto const& mobile_partials = timbres.mobile;
+	char const separator = options.delimiter();
+
+	auto const dissonances = disscalc::evaluate_chords(
+		chords,
+		options.thread_count(),
+		[&](double d) noexcept
+		{
+			return disscalc::compute_dissonance<Model>(
+				stable_partials,
+				mobile_partials,
+				d
+			);
+		}
+	);
+
+	return write_output(options, [&](std::ostream& out)
+	{
+		for (std::size_t i = 0; i < chords.size(); ++i)
+		{
+			disscalc::print_chord_dissonance(
+				out,
+				chords[i],
+				dissonances[i],
+				separator
+			);
+		}
+	});
 }
 
 int main(int argc, char const* argv[])
@@ -81,7 +1230,51 @@ int main(int argc, char const* argv[])
 		return 1;
 	}
 
-	if (!output_table(options))
+	auto const timbres = load_timbres(options);
+	if (!timbres.has_value() || !load_extra_values(options))
+	{
+		return 2;
+	}
+
+	auto const fingerprint = disscalc::fingerprint_inputs(
+		disscalc::fingerprint_arguments(
+			std::span(argv, static_cast<std::size_t>(argc))
+		),
+		timbres->stable,
+		timbres->mobile,
+		options.extra_values()
+	);
+
+	bool const succeeded = disscalc::visit_dissonance_model(
+		options.model(),
+		[&](auto model)
+		{
+			if (options.frames_file().has_value())
+			{
+				return output_frames(options, *timbres, model);
+			}
+			if (options.mobile_timbres_file().has_value())
+			{
+				return output_wide_table(options, *timbres, model);
+			}
+			if (options.chords_file().has_value())
+			{
+				return output_chords(options, *timbres, model);
+			}
+			if (options.sweep().has_value())
+			{
+				return output_sweep(options, *timbres, model);
+			}
+			if (options.optimizes_timbre())
+			{
+				return output_optimized_timbre(options, *timbres, model);
+			}
+			return options.evaluates_scales()
+				? output_scales(options, *timbres, model)
+				: output_table(options, fingerprint, *timbres, model);
+		}
+	);
+	if (!succeeded)
 	{
 		return 2;
 	}
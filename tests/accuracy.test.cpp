@@ -0,0 +1,527 @@
+/*
+ * Differential accuracy harness.
+ *
+ * Every fast path for computing dissonances is compared against the scalar
+ * reference, `compute_dissonance`, over randomized and pathological timbres
+ * and intervals. The largest absolute, relative and ULP errors of each engine
+ * are printed, and a test fails when any exceeds the bound for its engine.
+ */
+#include "disscalc/blocked-engine.hpp"
+#include "disscalc/chebyshev-curve.hpp"
+#include "disscalc/dissonance.hpp"
+#include "disscalc/fft-engine.hpp"
+#include "disscalc/incremental-curve.hpp"
+#include "disscalc/reduction.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+// Timbres and intervals on which every engine is compared.
+struct AccuracyCase
+{
+	std::string name;
+	std::vector<disscalc::Partial> stable;
+	std::vector<disscalc::Partial> mobile;
+	std::vector<double> intervals;
+};
+
+// Largest errors allowed for an engine.
+struct AccuracyBound
+{
+	double absolute = std::numeric_limits<double>::infinity();
+
+	// Relative to the greatest magnitude of the reference.
+	double relative = std::numeric_limits<double>::infinity();
+
+	std::uint64_t ulp = std::numeric_limits<std::uint64_t>::max();
+};
+
+// Largest errors measured for an engine.
+struct AccuracyError
+{
+	double absolute = 0.0;
+	double relative = 0.0;
+	std::uint64_t ulp = 0;
+
+	[[nodiscard]]
+	bool is_within(AccuracyBound const& bound) const noexcept
+	{
+		return absolute <= bound.absolute
+			&& relative <= bound.relative
+			&& ulp <= bound.ulp;
+	}
+};
+
+// Get the number of representable doubles between `a` and `b`.
+[[nodiscard]] static
+std::uint64_t ulp_distance(double a, double b) noexcept
+{
+	if (a == b)
+	{
+		return 0;
+	}
+	if (std::isnan(a) || std::isnan(b))
+	{
+		return std::numeric_limits<std::uint64_t>::max();
+	}
+
+	// Map the bits to integers ordered in the same way as the doubles.
+	auto const ordered = [](double x) noexcept
+	{
+		auto const bits = std::bit_cast<std::uint64_t>(x);
+		return bits >> 63 != 0 ? ~bits : bits | (std::uint64_t(1) << 63);
+	};
+	auto const ordered_a = ordered(a);
+	auto const ordered_b = ordered(b);
+	return ordered_a > ordered_b
+		? ordered_a - ordered_b
+		: ordered_b - ordered_a;
+}
+
+// Get the errors of `approximate` against `reference`.
+[[nodiscard]] static
+auto measure_error(
+	std::span<double const> approximate,
+	std::span<double const> reference
+) -> AccuracyError
+{
+	REQUIRE(approximate.size() == reference.size());
+
+	AccuracyError error;
+	double greatest = 0.0;
+	for (std::size_t i = 0; i < reference.size(); ++i)
+	{
+		auto const difference = std::abs(approximate[i] - reference[i]);
+		error.absolute = std::isnan(difference)
+			? std::numeric_limits<double>::infinity()
+			: std::max(error.absolute, difference);
+		error.ulp = std::max(
+			error.ulp,
+			ulp_distance(approximate[i], reference[i])
+		);
+		greatest = std::max(greatest, std::abs(reference[i]));
+	}
+	error.relative = greatest > 0.0
+		? error.absolute / greatest
+		: error.absolute;
+	return error;
+}
+
+// Get `count` values evenly spaced on a log scale from `first` to `last`.
+[[nodiscard]] static
+auto geometric_values(double first, double last, std::size_t count)
+	-> std::vector<double>
+{
+	std::vector<double> values;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		auto const t = static_cast<double>(i) / static_cast<double>(count - 1);
+		values.push_back(first * std::pow(last / first, t));
+	}
+	return values;
+}
+
+// Get `count` intervals evenly spaced from `first` to `last`.
+[[nodiscard]] static
+auto interval_grid(double first, double last, std::size_t count)
+	-> std::vector<double>
+{
+	std::vector<double> intervals;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		auto const t = static_cast<double>(i) / static_cast<double>(count - 1);
+		intervals.push_back(first + (last - first) * t);
+	}
+	return intervals;
+}
+
+// Create the cases on which engines are compared under `Model`.
+template <disscalc::DissonanceModelPolicy Model>
+[[nodiscard]] static
+auto make_accuracy_cases(void) -> std::vector<AccuracyCase>
+{
+	std::vector<AccuracyCase> cases;
+
+	std::mt19937 rng(41);
+	std::uniform_real_distribution<double> log_frequency(
+		std::log(200.0),
+		std::log(4000.0)
+	);
+	std::uniform_real_distribution<double> log_amplitude(
+		std::log(1e-3),
+		0.0
+	);
+	auto const random_timbre = [&](std::size_t size)
+	{
+		std::vector<disscalc::Partial> partials;
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			partials.push_back({
+				std::exp(log_frequency(rng)),
+				std::exp(log_amplitude(rng))
+			});
+		}
+		return partials;
+	};
+	cases.push_back({
+		"random",
+		random_timbre(24),
+		random_timbre(16),
+		interval_grid(1.0, 2.0, 601)
+	});
+
+	std::vector<disscalc::Partial> harmonic;
+	for (int k = 1; k <= 16; ++k)
+	{
+		harmonic.push_back({110.0 * k, 1.0 / k});
+	}
+	cases.push_back({
+		"intervals below 1",
+		harmonic,
+		harmonic,
+		interval_grid(0.25, 1.0, 601)
+	});
+
+	cases.push_back({
+		"extreme frequencies",
+		{{5.0, 1.0}, {20.0, 0.5}, {19000.0, 0.7}, {60000.0, 0.2}},
+		{{8.0, 0.9}, {21.5, 0.3}, {20000.0, 1.0}},
+		interval_grid(0.9, 1.1, 401)
+	});
+
+	std::vector<disscalc::Partial> loud_and_faint;
+	auto const amplitudes = geometric_values(1e-12, 1e6, 19);
+	auto const frequencies = geometric_values(100.0, 4000.0, 19);
+	for (std::size_t i = 0; i < amplitudes.size(); ++i)
+	{
+		loud_and_faint.push_back({frequencies[i], amplitudes[i]});
+	}
+	std::ranges::shuffle(loud_and_faint, rng);
+	cases.push_back({
+		"huge amplitude range",
+		loud_and_faint,
+		random_timbre(12),
+		interval_grid(1.0, 2.0, 601)
+	});
+
+	/*
+	 * Place mobile partials where each exponential of the kernel crosses the
+	 * -88 cutoff as the interval goes from below 1 to above 1.
+	 */
+	double const stable_frequency = 1000.0;
+	double const scale = Model::dstar
+		/ (Model::s1 * stable_frequency + Model::s2);
+	std::vector<disscalc::Partial> near_cutoff;
+	for (auto const exponent : {Model::a1, Model::a2})
+	{
+		auto const difference = -88.0 / (exponent * scale);
+		near_cutoff.push_back({stable_frequency + difference, 1.0});
+	}
+	cases.push_back({
+		"near cutoff",
+		{{stable_frequency, 1.0}},
+		near_cutoff,
+		interval_grid(0.999, 1.001, 401)
+	});
+
+	return cases;
+}
+
+/*
+ * Compare `engine(case)` with the reference for every case, print the largest
+ * errors and check them against `bound`.
+ */
+template <disscalc::DissonanceModelPolicy Model>
+static
+void check_engine(
+	std::string const& name,
+	AccuracyBound const& bound,
+	std::invocable<AccuracyCase const&> auto engine
+)
+{
+	AccuracyError worst;
+	for (auto const& accuracy_case : make_accuracy_cases<Model>())
+	{
+		std::vector<double> reference;
+		for (auto const interval : accuracy_case.intervals)
+		{
+			reference.push_back(disscalc::compute_dissonance<Model>(
+				accuracy_case.stable,
+				accuracy_case.mobile,
+				interval
+			));
+		}
+
+		std::vector<double> const approximate = engine(accuracy_case);
+		auto const error = measure_error(approximate, reference);
+
+		INFO(name << " engine, " << Model::name << " model, "
+			<< accuracy_case.name << ": max absolute " << error.absolute
+			<< ", relative " << error.relative << ", ULP " << error.ulp);
+		CHECK(error.is_within(bound));
+
+		worst.absolute = std::max(worst.absolute, error.absolute);
+		worst.relative = std::max(worst.relative, error.relative);
+		worst.ulp = std::max(worst.ulp, error.ulp);
+	}
+
+	std::cout << name << " engine, " << Model::name << " model: max absolute "
+		<< worst.absolute << ", relative " << worst.relative << ", ULP "
+		<< worst.ulp << '\n';
+}
+
+TEMPLATE_TEST_CASE(
+	"Batched dissonances match the reference",
+	"[accuracy]",
+	disscalc::SetharesModel,
+	disscalc::ProductModel,
+	disscalc::VassilakisModel
+)
+{
+	check_engine<TestType>(
+		"batch",
+		{.ulp = 0},
+		[](AccuracyCase const& accuracy_case)
+		{
+			std::vector<std::vector<disscalc::Partial>> const mobile = {
+				accuracy_case.mobile
+			};
+			std::vector<double> dissonances;
+			double dissonance;
+			for (auto const interval : accuracy_case.intervals)
+			{
+				disscalc::compute_dissonances<TestType>(
+					accuracy_case.stable,
+					mobile,
+					interval,
+					{&dissonance, 1}
+				);
+				dissonances.push_back(dissonance);
+			}
+			return dissonances;
+		}
+	);
+}
+
+TEMPLATE_TEST_CASE(
+	"Blocked curves match the reference",
+	"[accuracy]",
+	disscalc::SetharesModel,
+	disscalc::ProductModel,
+	disscalc::VassilakisModel
+)
+{
+	check_engine<TestType>(
+		"blocked",
+		{.ulp = 0},
+		[](AccuracyCase const& accuracy_case)
+		{
+			std::vector<double> dissonances(accuracy_case.intervals.size());
+			disscalc::compute_dissonance_curve_blocked<TestType>(
+				accuracy_case.stable,
+				accuracy_case.mobile,
+				accuracy_case.intervals,
+				dissonances,
+				0
+			);
+			return dissonances;
+		}
+	);
+}
+
+TEMPLATE_TEST_CASE(
+	"FFT curves are within tolerance of the reference",
+	"[accuracy]",
+	disscalc::SetharesModel,
+	disscalc::ProductModel
+)
+{
+	check_engine<TestType>(
+		"fft",
+		{.relative = 0.01},
+		[](AccuracyCase const& accuracy_case)
+		{
+			return disscalc::compute_dissonance_curve_fft<TestType>(
+				accuracy_case.stable,
+				accuracy_case.mobile,
+				accuracy_case.intervals
+			);
+		}
+	);
+}
+
+TEMPLATE_TEST_CASE(
+	"Chebyshev curves are within tolerance of the reference",
+	"[accuracy]",
+	disscalc::SetharesModel,
+	disscalc::ProductModel,
+	disscalc::VassilakisModel
+)
+{
+	// Tolerance relative to the greatest dissonance of each case.
+	double const tolerance = 1e-6;
+
+	check_engine<TestType>(
+		"chebyshev",
+		{.relative = tolerance},
+		[&](AccuracyCase const& accuracy_case)
+		{
+			auto const dissonance_at = [&](double interval)
+			{
+				return disscalc::compute_dissonance<TestType>(
+					accuracy_case.stable,
+					accuracy_case.mobile,
+					interval
+				);
+			};
+
+			double greatest = 0.0;
+			for (auto const interval : accuracy_case.intervals)
+			{
+				greatest = std::max(
+					greatest,
+					std::abs(dissonance_at(interval))
+				);
+			}
+
+			auto const curve = disscalc::fit_chebyshev_curve(
+				accuracy_case.intervals.front(),
+				accuracy_case.intervals.back(),
+				tolerance * greatest,
+				16,
+				dissonance_at
+			);
+			std::vector<double> dissonances;
+			for (auto const interval : accuracy_case.intervals)
+			{
+				dissonances.push_back(curve(interval));
+			}
+			return dissonances;
+		}
+	);
+}
+
+TEMPLATE_TEST_CASE(
+	"Reduced timbres are within tolerance of the reference",
+	"[accuracy]",
+	disscalc::SetharesModel,
+	disscalc::ProductModel,
+	disscalc::VassilakisModel
+)
+{
+	// Maximum error relative to the greatest dissonance of each case.
+	double const max_error = 1e-3;
+
+	check_engine<TestType>(
+		"reduction",
+		{.relative = max_error},
+		[&](AccuracyCase const& accuracy_case)
+		{
+			std::vector<double> reference;
+			for (auto const interval : accuracy_case.intervals)
+			{
+				reference.push_back(disscalc::compute_dissonance<TestType>(
+					accuracy_case.stable,
+					accuracy_case.mobile,
+					interval
+				));
+			}
+			auto const greatest = std::ranges::max(
+				reference,
+				{},
+				[](double x) { return std::abs(x); }
+			);
+
+			auto stable = accuracy_case.stable;
+			auto mobile = accuracy_case.mobile;
+			auto const report = disscalc::reduce_partials<TestType>(
+				stable,
+				mobile,
+				false,
+				{
+					accuracy_case.intervals.front(),
+					accuracy_case.intervals.back()
+				},
+				max_error * std::abs(greatest)
+			);
+			(void)report;
+
+			std::vector<double> dissonances;
+			for (auto const interval : accuracy_case.intervals)
+			{
+				dissonances.push_back(disscalc::compute_dissonance<TestType>(
+					stable,
+					mobile,
+					interval
+				));
+			}
+			return dissonances;
+		}
+	);
+}
+
+TEMPLATE_TEST_CASE(
+	"Incremental curves are within tolerance of the reference",
+	"[accuracy]",
+	disscalc::SetharesModel,
+	disscalc::ProductModel,
+	disscalc::VassilakisModel
+)
+{
+	using disscalc::TimbreSide;
+
+	/*
+	 * Reach the partials of each case through a series of updates without
+	 * rebuilding, so the error is the rounding error built up by them.
+	 */
+	check_engine<TestType>(
+		"incremental",
+		{.relative = 1e-12},
+		[](AccuracyCase const& accuracy_case)
+		{
+			auto const& stable = accuracy_case.stable;
+			auto const& mobile = accuracy_case.mobile;
+			auto const half = stable.size() / 2;
+
+			auto first_mobile = mobile;
+			first_mobile.front().frequency *= 1.5;
+			first_mobile.front().amplitude *= 0.5;
+			auto first_stable = std::vector<disscalc::Partial>(
+				stable.begin(),
+				stable.begin() + static_cast<std::ptrdiff_t>(half)
+			);
+			first_stable.push_back({stable.front().frequency * 1.01, 1.0});
+
+			disscalc::IncrementalCurve<TestType> curve(
+				first_stable,
+				first_mobile,
+				accuracy_case.intervals,
+				0,
+				std::numeric_limits<std::size_t>::max()
+			);
+			curve.remove_partial(TimbreSide::stable, half);
+			for (auto i = half; i < stable.size(); ++i)
+			{
+				curve.add_partial(TimbreSide::stable, stable[i]);
+			}
+			for (std::size_t i = 0; i < mobile.size(); ++i)
+			{
+				curve.set_partial(TimbreSide::mobile, i, mobile[i]);
+			}
+
+			auto const dissonances = curve.dissonances();
+			return std::vector<double>(dissonances.begin(), dissonances.end());
+		}
+	);
+}
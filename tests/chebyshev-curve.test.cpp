@@ -0,0 +1,118 @@
+#include "disscalc/chebyshev-curve.hpp"
+#include "disscalc/dissonance.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+TEST_CASE("Evaluate Chebyshev series", "[chebyshev-curve]")
+{
+	// Fitting a polynomial of lesser degree than the series is exact.
+	std::vector<double> values(5);
+	for (std::size_t k = 0; k < values.size(); ++k)
+	{
+		auto const t = std::cos(
+			std::numbers::pi * (static_cast<double>(k) + 0.5) / 5.0
+		);
+		values[k] = 2.0 * t * t * t - t + 0.5;
+	}
+	auto const coefficients = disscalc::fit_chebyshev_coefficients(values);
+
+	for (double t = -1.0; t <= 1.0; t += 0.125)
+	{
+		REQUIRE(
+			disscalc::evaluate_chebyshev(coefficients, t)
+			== Approx(2.0 * t * t * t - t + 0.5).margin(1e-12)
+		);
+	}
+}
+
+TEST_CASE("Fit curves within tolerance", "[chebyshev-curve]")
+{
+	std::vector<disscalc::Partial> const timbre = {
+		{220.0, 1.0},
+		{440.0, 0.5},
+		{660.0, 0.33},
+		{880.0, 0.25},
+	};
+	auto const dissonance = [&](double x) noexcept
+	{
+		return disscalc::compute_dissonance(timbre, timbre, x);
+	};
+
+	double const tolerance = 1e-5;
+	auto const curve = disscalc::fit_chebyshev_curve(
+		1.0,
+		2.5,
+		tolerance,
+		12,
+		dissonance
+	);
+	REQUIRE(curve.segments().size() > 1);
+	REQUIRE(curve.error_bound() <= tolerance);
+
+	double max_error = 0.0;
+	for (std::size_t i = 0; i <= 20000; ++i)
+	{
+		auto const x = 1.0 + 1.5 * static_cast<double>(i) / 20000.0;
+		max_error = std::max(max_error, std::abs(curve(x) - dissonance(x)));
+	}
+	REQUIRE(max_error <= tolerance);
+
+	// Queries outside the range are clamped.
+	REQUIRE(curve(0.5) == curve(1.0));
+	REQUIRE(curve(3.0) == curve(2.5));
+}
+
+TEST_CASE("Report curves that cannot be fitted", "[chebyshev-curve]")
+{
+	// No polynomial comes within the tolerance of a jump, however short.
+	auto const step = [](double x) noexcept { return x < 1.3 ? 0.0 : 1.0; };
+
+	double const tolerance = 1e-3;
+	auto const curve = disscalc::fit_chebyshev_curve(
+		1.0,
+		2.0,
+		tolerance,
+		4,
+		step
+	);
+	REQUIRE(curve.error_bound() > tolerance);
+}
+
+TEST_CASE("Serialize Chebyshev curves", "[chebyshev-curve]")
+{
+	auto const curve = disscalc::fit_chebyshev_curve(
+		0.5,
+		4.0,
+		1e-9,
+		10,
+		[](double x) noexcept { return std::sin(3.0 * x) / x; }
+	);
+
+	std::stringstream stream;
+	disscalc::write_chebyshev_curve(stream, curve);
+	auto const bytes = stream.str();
+
+	auto const read = disscalc::read_chebyshev_curve(stream);
+	REQUIRE(read.has_value());
+	REQUIRE(read->first() == 0.5);
+	REQUIRE(read->last() == 4.0);
+	REQUIRE(read->segments().size() == curve.segments().size());
+	for (double x = 0.5; x <= 4.0; x += 0.01)
+	{
+		REQUIRE((*read)(x) == curve(x));
+	}
+
+	std::istringstream truncated(bytes.substr(0, bytes.size() - 1));
+	REQUIRE(!disscalc::read_chebyshev_curve(truncated).has_value());
+
+	// A segment whose depth is changed no longer fits the range.
+	auto corrupted = bytes;
+	corrupted[8 + 8 + 8 + 8] ^= 1;
+	std::istringstream corrupted_in(corrupted);
+	REQUIRE(!disscalc::read_chebyshev_curve(corrupted_in).has_value());
+}
@@ -0,0 +1,88 @@
+#include "disscalc/chords.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+TEST_CASE("Parse chord pitches", "[chords]")
+{
+	auto const fraction = disscalc::parse_chord_pitch("10/8");
+	REQUIRE(fraction.has_value());
+	REQUIRE(fraction->ratio == 1.25);
+	REQUIRE(fraction->fraction == disscalc::Fraction{5, 4});
+
+	auto const whole = disscalc::parse_chord_pitch("3");
+	REQUIRE(whole->fraction == disscalc::Fraction{3, 1});
+
+	auto const cents = disscalc::parse_chord_pitch("1200.0");
+	REQUIRE(cents.has_value());
+	REQUIRE(cents->ratio == Approx(2.0));
+	REQUIRE(!cents->fraction.has_value());
+
+	REQUIRE(!disscalc::parse_chord_pitch("0/1").has_value());
+	REQUIRE(!disscalc::parse_chord_pitch("3/0").has_value());
+	REQUIRE(!disscalc::parse_chord_pitch("3/2x").has_value());
+	REQUIRE(!disscalc::parse_chord_pitch("-1").has_value());
+}
+
+TEST_CASE("Read chords", "[chords]")
+{
+	std::istringstream in("# triads\n1/1 5/4 3/2\n\n  4/4\t6/5 3/2 \n");
+	auto const list = disscalc::read_chords(in);
+	REQUIRE(!list.error_line.has_value());
+	REQUIRE(list.chords.size() == 2);
+	REQUIRE(list.chords[1].name == "4/4\t6/5 3/2");
+	REQUIRE(list.chords[1].pitches.size() == 3);
+
+	std::istringstream single("1/1 3/2\n5/4\n");
+	REQUIRE(disscalc::read_chords(single).error_line == 2);
+
+	std::istringstream malformed("1/1 3/2 x\n");
+	REQUIRE(disscalc::read_chords(malformed).error_line == 1);
+}
+
+TEST_CASE("Share intervals between chords", "[chords]")
+{
+	std::istringstream in(
+		"1/1 5/4 3/2\n"
+		"6/5 3/2 9/5\n"
+		"3/2 1/1 5/4\n"
+		"0.0 386.3137 701.955\n"
+	);
+	auto const chords = disscalc::read_chords(in).chords;
+
+	auto const indexed = disscalc::index_chord_intervals(chords);
+	REQUIRE(indexed.pair_intervals.size() == 12);
+	REQUIRE(indexed.first_pairs == std::vector<std::size_t>{0, 3, 6, 9});
+
+	// The exact ratios 5/4, 6/5 and 3/2 are shared between the first three
+	// chords, while intervals in cents are only equal if their values are.
+	REQUIRE(indexed.intervals.size() >= 4);
+	REQUIRE(indexed.intervals.size() <= 6);
+	for (std::size_t pair = 0; pair < 3; ++pair)
+	{
+		REQUIRE(indexed.pair_intervals[pair] < 3);
+	}
+
+	std::atomic<std::size_t> call_count = 0;
+	auto const dissonances = disscalc::evaluate_chords(
+		chords,
+		2,
+		[&](double interval) noexcept
+		{
+			++call_count;
+			return std::log(interval);
+		}
+	);
+	REQUIRE(call_count == indexed.intervals.size());
+	REQUIRE(dissonances.size() == 4);
+
+	// The sum of the logs of the intervals of a triad is twice its span.
+	REQUIRE(dissonances[0] == Approx(2.0 * std::log(1.5)));
+	REQUIRE(dissonances[1] == Approx(2.0 * std::log(1.5)));
+	REQUIRE(dissonances[2] == Approx(dissonances[0]));
+	REQUIRE(dissonances[3] == Approx(2.0 * std::log(1.5)).epsilon(1e-5));
+}
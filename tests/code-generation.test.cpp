@@ -0,0 +1,71 @@
+#include "disscalc/code-generation.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+TEST_CASE("Validate C++ namespaces", "[code-generation]")
+{
+	REQUIRE(disscalc::is_valid_cpp_namespace("dissonance_curve"));
+	REQUIRE(disscalc::is_valid_cpp_namespace("curves::piano_2"));
+	REQUIRE(!disscalc::is_valid_cpp_namespace(""));
+	REQUIRE(!disscalc::is_valid_cpp_namespace("2curves"));
+	REQUIRE(!disscalc::is_valid_cpp_namespace("curves::"));
+	REQUIRE(!disscalc::is_valid_cpp_namespace("curves:piano"));
+	REQUIRE(!disscalc::is_valid_cpp_namespace("curves; int x"));
+}
+
+TEST_CASE("Write tables as C++ headers", "[code-generation]")
+{
+	std::vector<disscalc::TableRow> const rows = {
+		{1.0, 0.1, false},
+		{1.01, 1.0 / 3.0, false},
+		{1.25, 0.0, true},
+		{2.0, 1e-300, false},
+	};
+
+	std::ostringstream out;
+	disscalc::write_table_as_cpp(out, rows, {"curves::piano", true});
+	auto const header = out.str();
+
+	REQUIRE(header.find("namespace curves::piano\n") != std::string::npos);
+	REQUIRE(header.find("size = 4;") != std::string::npos);
+	REQUIRE(header.find("constexpr double interpolate(") != std::string::npos);
+
+	// Every number reads back exactly.
+	auto const read_array = [&](std::string const& name)
+	{
+		std::vector<double> values;
+		auto position = header.find(name + "[size] = {");
+		REQUIRE(position != std::string::npos);
+		position = header.find('{', position) + 1;
+		while (true)
+		{
+			char* end;
+			auto const value = std::strtod(header.c_str() + position, &end);
+			if (end == header.c_str() + position)
+			{
+				break;
+			}
+			values.push_back(value);
+			position = static_cast<std::size_t>(end - header.c_str()) + 1;
+		}
+		return values;
+	};
+	REQUIRE(read_array("intervals") == std::vector{1.0, 1.01, 1.25, 2.0});
+	REQUIRE(
+		read_array("dissonances")
+		== std::vector{0.1, 1.0 / 3.0, 0.0, 1e-300}
+	);
+
+	std::ostringstream plain;
+	disscalc::write_table_as_cpp(plain, rows, {});
+	auto const plain_header = plain.str();
+	REQUIRE(
+		plain_header.find("namespace dissonance_curve\n") != std::string::npos
+	);
+	REQUIRE(plain_header.find("interpolate") == std::string::npos);
+}
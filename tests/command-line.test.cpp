@@ -40,7 +40,6 @@ auto amps_view(std::ranges::borrowed_range auto&& partials)
 TEST_CASE("Parse command line options", "[command-line]")
 {
 	using DVec = std::vector<double>;
-	using DSet = std::set<double>;
 
 	std::vector<char const*> v0 = {};
 	disscalc::ProgramOptions o0(v0.size(), v0.data());
@@ -113,7 +112,7 @@ TEST_CASE("Parse command line options", "[command-line]")
 		"-x", "3.2", "9.5", "5.7"
 	};
 	disscalc::ProgramOptions o6(v6.size(), v6.data());
-	REQUIRE(approx_equals(o6.extra_values(), DSet{3.2, 9.5, 5.7}));
+	REQUIRE(approx_equals(o6.extra_values(), DVec{3.2, 5.7, 9.5}));
 
 	std::vector<char const*> v7 = {};
 	disscalc::ProgramOptions o7(v7.size(), v7.data());
@@ -152,4 +151,338 @@ TEST_CASE("Parse command line options", "[command-line]")
 	};
 	disscalc::ProgramOptions o10(v10.size(), v10.data());
 	REQUIRE(!o10.is_valid());
+
+	std::vector<char const*> v11 = {
+		"disscalc",
+		"--edo=5-200", "--scale=a.scl", "--scale=b.scl",
+		"--chord-size=4", "-j", "3"
+	};
+	disscalc::ProgramOptions o11(v11.size(), v11.data());
+	REQUIRE(o11.is_valid());
+	REQUIRE(o11.evaluates_scales());
+	REQUIRE(o11.edo_range()->first == 5);
+	REQUIRE(o11.edo_range()->last == 200);
+	REQUIRE(o11.scale_files().size() == 2);
+	REQUIRE(o11.scale_files()[1] == "b.scl");
+	REQUIRE(o11.chord_size() == 4);
+	REQUIRE(o11.thread_count() == 3);
+
+	std::vector<char const*> v12 = {
+		"disscalc",
+		"--edo=12"
+	};
+	disscalc::ProgramOptions o12(v12.size(), v12.data());
+	REQUIRE(o12.is_valid());
+	REQUIRE(o12.edo_range()->first == 12);
+	REQUIRE(o12.edo_range()->last == 12);
+	REQUIRE(!o7.evaluates_scales());
+
+	std::vector<char const*> v13 = {
+		"disscalc",
+		"--edo=20-10", "--chord-size=1"
+	};
+	disscalc::ProgramOptions o13(v13.size(), v13.data());
+	REQUIRE(!o13.is_valid());
+	REQUIRE(o13.errors().size() == 2);
+
+	std::vector<char const*> v14 = {
+		"disscalc",
+		"--edo=5-x"
+	};
+	disscalc::ProgramOptions o14(v14.size(), v14.data());
+	REQUIRE(!o14.is_valid());
+
+	std::vector<char const*> v15 = {
+		"disscalc",
+		"--model=vassilakis"
+	};
+	disscalc::ProgramOptions o15(v15.size(), v15.data());
+	REQUIRE(o15.is_valid());
+	REQUIRE(o15.model() == disscalc::DissonanceModel::vassilakis);
+	REQUIRE(o7.model() == disscalc::DissonanceModel::sethares);
+
+	std::vector<char const*> v16 = {
+		"disscalc",
+		"-m", "plomp"
+	};
+	disscalc::ProgramOptions o16(v16.size(), v16.data());
+	REQUIRE(!o16.is_valid());
+
+	std::vector<char const*> v17 = {
+		"disscalc",
+		"--timbre-from-wav=sound.wav", "--fft-size=1024",
+		"--peak-threshold=-30", "--max-peaks=12"
+	};
+	disscalc::ProgramOptions o17(v17.size(), v17.data());
+	REQUIRE(o17.is_valid());
+	REQUIRE(o17.timbre_wav_file() == "sound.wav");
+	REQUIRE(o17.fft_size() == 1024);
+	REQUIRE(o17.peak_settings().threshold_db == Approx(-30.0));
+	REQUIRE(o17.peak_settings().max_peaks == 12);
+	REQUIRE(!o17.has_mobile_partials());
+
+	std::vector<char const*> v18 = {
+		"disscalc",
+		"--timbre-from-wav=sound.wav", "--fft-size=1000",
+		"-p", "100", "-a", "1"
+	};
+	disscalc::ProgramOptions o18(v18.size(), v18.data());
+	REQUIRE(!o18.is_valid());
+	REQUIRE(o18.errors().size() == 2);
+
+	std::vector<char const*> v19 = {
+		"disscalc",
+		"--max-error=0.01"
+	};
+	disscalc::ProgramOptions o19(v19.size(), v19.data());
+	REQUIRE(o19.is_valid());
+	REQUIRE(o19.max_error() == Approx(0.01));
+	REQUIRE(!o7.max_error().has_value());
+
+	std::vector<char const*> v20 = {
+		"disscalc",
+		"--max-error=0"
+	};
+	disscalc::ProgramOptions o20(v20.size(), v20.data());
+	REQUIRE(!o20.is_valid());
+
+	std::vector<char const*> v21 = {
+		"disscalc",
+		"--shard=2/5", "--checkpoint=progress", "-o", "out.csv",
+		"--checkpoint-interval=0.5"
+	};
+	disscalc::ProgramOptions o21(v21.size(), v21.data());
+	REQUIRE(o21.is_valid());
+	REQUIRE(o21.shard()->index == 2);
+	REQUIRE(o21.shard()->count == 5);
+	REQUIRE(o21.checkpoint_file() == "progress");
+	REQUIRE(o21.checkpoint_interval() == Approx(0.5));
+
+	std::vector<char const*> v22 = {
+		"disscalc",
+		"--shard=5/5", "--checkpoint=progress"
+	};
+	disscalc::ProgramOptions o22(v22.size(), v22.data());
+	REQUIRE(!o22.is_valid());
+	REQUIRE(o22.errors().size() == 2);
+
+	std::vector<char const*> v23 = {
+		"disscalc",
+		"--decimate=0.001"
+	};
+	disscalc::ProgramOptions o23(v23.size(), v23.data());
+	REQUIRE(o23.is_valid());
+	REQUIRE(o23.decimation_tolerance() == Approx(0.001));
+
+	std::vector<char const*> v24 = {
+		"disscalc",
+		"--decimate=0.001", "--checkpoint=file", "-o", "out"
+	};
+	disscalc::ProgramOptions o24(v24.size(), v24.data());
+	REQUIRE(!o24.is_valid());
+
+	std::vector<char const*> v25 = {
+		"disscalc",
+		"--frames=-", "--frame-summary=minima", "--frame-tolerance=0.01"
+	};
+	disscalc::ProgramOptions o25(v25.size(), v25.data());
+	REQUIRE(o25.is_valid());
+	REQUIRE(o25.frames_file() == "-");
+	REQUIRE(o25.frame_summary() == disscalc::FrameSummary::minima);
+	REQUIRE(o25.frame_tolerance() == Approx(0.01));
+	REQUIRE(o7.frame_summary() == disscalc::FrameSummary::curve);
+
+	std::vector<char const*> v26 = {
+		"disscalc",
+		"--frames=frames.txt", "--frame-summary=maxima", "--edo=5-7"
+	};
+	disscalc::ProgramOptions o26(v26.size(), v26.data());
+	REQUIRE(!o26.is_valid());
+	REQUIRE(o26.errors().size() == 2);
+	REQUIRE(
+		o26.errors().back().type == disscalc::CommandLineErrorType::conflicting
+	);
+	REQUIRE(o26.errors().back().argument_text == "--scale or --edo");
+	REQUIRE(o26.errors().back().conflicting_text == "--frames");
+
+	std::vector<char const*> v27 = {
+		"disscalc",
+		"--sweep=rolloff:-1:2.5", "--sweep-count=8", "-f", "binary"
+	};
+	disscalc::ProgramOptions o27(v27.size(), v27.data());
+	REQUIRE(o27.is_valid());
+	REQUIRE(o27.writes_binary());
+	REQUIRE(o27.sweep()->parameter == disscalc::TimbreParameter::rolloff);
+	REQUIRE(o27.sweep()->first == Approx(-1.0));
+	REQUIRE(o27.sweep()->last == Approx(2.5));
+	REQUIRE(o27.sweep()->count == 8);
+	REQUIRE(!o7.sweep().has_value());
+
+	std::vector<char const*> v28 = {
+		"disscalc",
+		"--sweep=stretch:0:2", "--frames=-"
+	};
+	disscalc::ProgramOptions o28(v28.size(), v28.data());
+	REQUIRE(!o28.is_valid());
+	REQUIRE(o28.errors().size() == 2);
+
+	std::vector<char const*> v29 = {
+		"disscalc",
+		"--sweep=brightness:0:2"
+	};
+	disscalc::ProgramOptions o29(v29.size(), v29.data());
+	REQUIRE(!o29.is_valid());
+
+	std::vector<char const*> v30 = {
+		"disscalc",
+		"-f", "cpp", "--cpp-namespace=curves::piano", "--cpp-interpolation",
+		"--decimate=0.01"
+	};
+	disscalc::ProgramOptions o30(v30.size(), v30.data());
+	REQUIRE(o30.is_valid());
+	REQUIRE(o30.writes_cpp());
+	REQUIRE(o30.cpp_header_settings().namespace_name == "curves::piano");
+	REQUIRE(o30.cpp_header_settings().interpolation);
+	REQUIRE(!o7.cpp_header_settings().interpolation);
+
+	std::vector<char const*> v31 = {
+		"disscalc",
+		"-f", "cpp", "--cpp-namespace=piano-curve", "--edo=12"
+	};
+	disscalc::ProgramOptions o31(v31.size(), v31.data());
+	REQUIRE(!o31.is_valid());
+	REQUIRE(o31.errors().size() == 2);
+
+	std::vector<char const*> v32 = {
+		"disscalc",
+		"-f", "chebyshev", "--curve-tolerance=1e-8", "--curve-degree=20"
+	};
+	disscalc::ProgramOptions o32(v32.size(), v32.data());
+	REQUIRE(o32.is_valid());
+	REQUIRE(o32.writes_chebyshev());
+	REQUIRE(o32.curve_tolerance() == Approx(1e-8));
+	REQUIRE(o32.curve_degree() == 20);
+
+	std::vector<char const*> v33 = {
+		"disscalc",
+		"-f", "chebyshev", "--curve-degree=40", "-x", "3"
+	};
+	disscalc::ProgramOptions o33(v33.size(), v33.data());
+	REQUIRE(!o33.is_valid());
+	REQUIRE(o33.errors().size() == 2);
+
+	std::vector<char const*> v34 = {
+		"disscalc",
+		"--chords=chords.txt", "-j", "4", "-f", "tsv"
+	};
+	disscalc::ProgramOptions o34(v34.size(), v34.data());
+	REQUIRE(o34.is_valid());
+	REQUIRE(o34.chords_file() == "chords.txt");
+	REQUIRE(!o7.chords_file().has_value());
+
+	std::vector<char const*> v35 = {
+		"disscalc",
+		"--chords=chords.txt", "-f", "cpp"
+	};
+	disscalc::ProgramOptions o35(v35.size(), v35.data());
+	REQUIRE(!o35.is_valid());
+
+	std::vector<char const*> v36 = {
+		"disscalc",
+		"--mobile-timbres=candidates.txt", "-p", "220", "-a", "1"
+	};
+	disscalc::ProgramOptions o36(v36.size(), v36.data());
+	REQUIRE(o36.is_valid());
+	REQUIRE(o36.mobile_timbres_file() == "candidates.txt");
+	REQUIRE(!o7.mobile_timbres_file().has_value());
+
+	std::vector<char const*> v37 = {
+		"disscalc",
+		"--mobile-timbres=candidates.txt", "-P", "220", "-A", "1"
+	};
+	disscalc::ProgramOptions o37(v37.size(), v37.data());
+	REQUIRE(!o37.is_valid());
+	std::vector<char const*> v38 = {
+		"disscalc",
+		"--engine=fft", "-m", "product", "-p", "220", "-a", "1"
+	};
+	disscalc::ProgramOptions o38(v38.size(), v38.data());
+	REQUIRE(o38.is_valid());
+	REQUIRE(o38.engine() == disscalc::Engine::fft);
+	REQUIRE(o7.engine() == disscalc::Engine::exact);
+
+	std::vector<char const*> v39 = {
+		"disscalc",
+		"--engine=fft", "-m", "vassilakis", "--shard=0/2"
+	};
+	disscalc::ProgramOptions o39(v39.size(), v39.data());
+	REQUIRE(!o39.is_valid());
+	REQUIRE(o39.errors().size() == 2);
+
+	std::vector<char const*> v40 = {"disscalc", "--engine=fast"};
+	disscalc::ProgramOptions o40(v40.size(), v40.data());
+	REQUIRE(!o40.is_valid());
+	std::vector<char const*> v41 = {"disscalc", "--progressive", "-j", "2"};
+	disscalc::ProgramOptions o41(v41.size(), v41.data());
+	REQUIRE(o41.is_valid());
+	REQUIRE(o41.is_progressive());
+	REQUIRE(!o7.is_progressive());
+
+	std::vector<char const*> v42 = {
+		"disscalc",
+		"--progressive", "--decimate=0.1", "-f", "cpp"
+	};
+	disscalc::ProgramOptions o42(v42.size(), v42.data());
+	REQUIRE(!o42.is_valid());
+	std::vector<char const*> v43 = {
+		"disscalc",
+		"--engine=blocked", "-m", "vassilakis", "-j", "2"
+	};
+	disscalc::ProgramOptions o43(v43.size(), v43.data());
+	REQUIRE(o43.is_valid());
+	REQUIRE(o43.engine() == disscalc::Engine::blocked);
+
+	std::vector<char const*> v44 = {
+		"disscalc",
+		"-x", "1.5", "1.25", "--extra-file=ratios.txt", "-x", "1.5"
+	};
+	disscalc::ProgramOptions o44(v44.size(), v44.data());
+	REQUIRE(o44.is_valid());
+	REQUIRE(o44.extra_file() == "ratios.txt");
+	REQUIRE(o44.extra_values() == DVec{1.25, 1.5});
+	o44.add_extra_values({1.2, 1.5, 1.75});
+	REQUIRE(o44.extra_values() == DVec{1.2, 1.25, 1.5, 1.75});
+	REQUIRE(!o7.extra_file().has_value());
+
+	std::vector<char const*> v45 = {
+		"disscalc",
+		"--edo=12", "--optimize=both", "--frequency-range=20",
+		"--amplitude-range=3", "--optimize-iterations=10", "-p", "200",
+		"-a", "1"
+	};
+	disscalc::ProgramOptions o45(v45.size(), v45.data());
+	REQUIRE(o45.is_valid());
+	REQUIRE(o45.optimizes_timbre());
+	REQUIRE(!o7.optimizes_timbre());
+	auto const settings = o45.optimization_settings();
+	REQUIRE(settings.parameters == disscalc::OptimizedParameters::both);
+	REQUIRE(settings.frequency_range == Approx(20.0));
+	REQUIRE(settings.amplitude_range == Approx(3.0));
+	REQUIRE(settings.max_iterations == 10);
+
+	std::vector<char const*> v46 = {
+		"disscalc",
+		"--edo=12-19", "--optimize=frequencies"
+	};
+	disscalc::ProgramOptions o46(v46.size(), v46.data());
+	REQUIRE(!o46.is_valid());
+
+	std::vector<char const*> v47 = {
+		"disscalc",
+		"--edo=12", "--optimize=phases", "--amplitude-range=0.5", "-P", "1",
+		"-A", "1"
+	};
+	disscalc::ProgramOptions o47(v47.size(), v47.data());
+	REQUIRE(!o47.is_valid());
+	REQUIRE(o47.errors().size() == 3);
 }
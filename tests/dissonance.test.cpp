@@ -0,0 +1,129 @@
+#include "disscalc/blocked-engine.hpp"
+#include "disscalc/dissonance.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+TEMPLATE_TEST_CASE(
+	"Roughness keeps its order of evaluation",
+	"[dissonance]",
+	disscalc::SetharesModel,
+	disscalc::ProductModel,
+	disscalc::VassilakisModel
+)
+{
+	// Exported tables hold exact values, so the order of evaluation is fixed.
+	std::mt19937 rng(44);
+	std::uniform_real_distribution<double> frequency(20.0, 20000.0);
+	for (int i = 0; i < 1000; ++i)
+	{
+		double const a = frequency(rng);
+		double const b = frequency(rng);
+		double const s = TestType::dstar
+			/ (TestType::s1 * std::min(a, b) + TestType::s2);
+		double const arg1 = TestType::a1 * s * std::abs(b - a);
+		double const arg2 = TestType::a2 * s * std::abs(b - a);
+		double const expected =
+			TestType::c1 * (arg1 < -88 ? 0 : std::exp(arg1))
+			+ TestType::c2 * (arg2 < -88 ? 0 : std::exp(arg2));
+		REQUIRE(disscalc::compute_roughness<TestType>(a, b) == expected);
+	}
+}
+
+TEMPLATE_TEST_CASE(
+	"Several mobile timbres match separate computations",
+	"[dissonance]",
+	disscalc::SetharesModel,
+	disscalc::ProductModel,
+	disscalc::VassilakisModel
+)
+{
+	std::vector<disscalc::Partial> const stable = {
+		{220.0, 1.0},
+		{440.0, 0.5},
+		{660.0, 0.3},
+	};
+	std::vector<std::vector<disscalc::Partial>> const mobile_timbres = {
+		{{220.0, 1.0}, {440.0, 0.5}},
+		{{230.0, 0.8}, {461.0, 0.4}, {700.0, 0.2}},
+		{},
+	};
+
+	std::vector<double> dissonances(mobile_timbres.size());
+	for (double interval = 1.0; interval <= 2.0; interval += 0.01)
+	{
+		disscalc::compute_dissonances<TestType>(
+			stable,
+			mobile_timbres,
+			interval,
+			dissonances
+		);
+		for (std::size_t i = 0; i < mobile_timbres.size(); ++i)
+		{
+			REQUIRE(
+				dissonances[i]
+				== disscalc::compute_dissonance<TestType>(
+					stable,
+					mobile_timbres[i],
+					interval
+				)
+			);
+		}
+	}
+}
+
+TEMPLATE_TEST_CASE(
+	"Blocked curves match separate computations",
+	"[dissonance]",
+	disscalc::SetharesModel,
+	disscalc::ProductModel,
+	disscalc::VassilakisModel
+)
+{
+	// Sizes that leave partly filled tiles of both intervals and partials.
+	std::vector<disscalc::Partial> stable;
+	for (int k = 1; k <= 7; ++k)
+	{
+		stable.push_back({196.0 * k, 1.0 / k});
+	}
+	std::vector<disscalc::Partial> mobile;
+	for (std::size_t k = 1; k <= disscalc::blocked_mobile_tile + 3; ++k)
+	{
+		mobile.push_back({
+			220.0 + 3.7 * static_cast<double>(k),
+			1.0 / static_cast<double>(k)
+		});
+	}
+	std::vector<double> intervals;
+	for (std::size_t i = 0; i < 2 * disscalc::blocked_interval_tile + 5; ++i)
+	{
+		intervals.push_back(0.9 + 0.013 * static_cast<double>(i));
+	}
+
+	for (std::size_t const thread_count : {1, 3})
+	{
+		std::vector<double> dissonances(intervals.size());
+		disscalc::compute_dissonance_curve_blocked<TestType>(
+			stable,
+			mobile,
+			intervals,
+			dissonances,
+			thread_count
+		);
+		for (std::size_t i = 0; i < intervals.size(); ++i)
+		{
+			REQUIRE(
+				dissonances[i]
+				== disscalc::compute_dissonance<TestType>(
+					stable,
+					mobile,
+					intervals[i]
+				)
+			);
+		}
+	}
+}
@@ -0,0 +1,67 @@
+#include "disscalc/extra-values.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <sstream>
+#include <vector>
+
+TEST_CASE("Read extra values", "[extra-values]")
+{
+	using DVec = std::vector<double>;
+
+	std::istringstream sorted("# ratios\n1.25 1.5\n\n1.5 1.75\n2\n");
+	auto const sorted_list = disscalc::read_extra_values(sorted);
+	REQUIRE(!sorted_list.error_position.has_value());
+	REQUIRE(sorted_list.values == DVec{1.25, 1.5, 1.75, 2.0});
+
+	std::istringstream unsorted("2 1.5\n1.25 2 1.5\n");
+	auto const unsorted_list = disscalc::read_extra_values(unsorted);
+	REQUIRE(!unsorted_list.error_position.has_value());
+	REQUIRE(unsorted_list.values == DVec{1.25, 1.5, 2.0});
+
+	// Reading stops at the first malformed line.
+	std::istringstream malformed("1.5\n# 0\n1.25 -2\nx\n");
+	auto const malformed_list = disscalc::read_extra_values(malformed);
+	REQUIRE(malformed_list.error_position == 3);
+	REQUIRE(malformed_list.values.empty());
+
+	std::istringstream empty("");
+	REQUIRE(disscalc::read_extra_values(empty).values.empty());
+}
+
+TEST_CASE("Read extra values in binary", "[extra-values]")
+{
+	using DVec = std::vector<double>;
+
+	std::stringstream buffer;
+	disscalc::write_extra_values(buffer, {3.0, 1.5, 3.0, 0.75});
+	auto const list = disscalc::read_extra_values(buffer);
+	REQUIRE(!list.error_position.has_value());
+	REQUIRE(list.values == DVec{0.75, 1.5, 3.0});
+
+	// A truncated value is malformed.
+	std::stringstream truncated;
+	disscalc::write_extra_values(truncated, {1.5, 2.0});
+	auto const bytes = truncated.str();
+	std::istringstream partial(bytes.substr(0, bytes.size() - 1));
+	REQUIRE(disscalc::read_extra_values(partial).error_position == 2);
+
+	std::istringstream wrong_magic("DISSCHEB");
+	REQUIRE(disscalc::read_extra_values(wrong_magic).error_position == 1);
+}
+
+TEST_CASE("Merge extra values", "[extra-values]")
+{
+	using DVec = std::vector<double>;
+
+	DVec values{2.0, 1.0, 2.0, 1.5};
+	disscalc::sort_extra_values(values);
+	REQUIRE(values == DVec{1.0, 1.5, 2.0});
+
+	REQUIRE(
+		disscalc::merge_extra_values(values, {0.5, 1.5, 3.0})
+			== DVec{0.5, 1.0, 1.5, 2.0, 3.0}
+	);
+	REQUIRE(disscalc::merge_extra_values({}, values) == values);
+	REQUIRE(disscalc::merge_extra_values(values, {}) == values);
+}
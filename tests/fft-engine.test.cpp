@@ -0,0 +1,67 @@
+#include "disscalc/dissonance.hpp"
+#include "disscalc/engine.hpp"
+#include "disscalc/fft-engine.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+TEMPLATE_TEST_CASE(
+	"FFT curves are close to exact curves",
+	"[fft-engine]",
+	disscalc::SetharesModel,
+	disscalc::ProductModel
+)
+{
+	std::vector<disscalc::Partial> stable;
+	for (int i = 1; i <= 12; ++i)
+	{
+		stable.push_back({261.63 * i, 1.0 / i});
+	}
+	std::vector<disscalc::Partial> const mobile = {
+		{220.0, 1.0},
+		{441.0, 0.6},
+		{665.0, 0.4},
+		{890.0, 0.3},
+	};
+
+	std::vector<double> intervals;
+	for (double interval = 1.0; interval <= 2.0; interval += 0.001)
+	{
+		intervals.push_back(interval);
+	}
+
+	auto const curve = disscalc::compute_dissonance_curve_fft<TestType>(
+		stable,
+		mobile,
+		intervals
+	);
+	REQUIRE(curve.size() == intervals.size());
+
+	auto const error = disscalc::measure_engine_error(
+		intervals,
+		curve,
+		intervals.size(),
+		[&](double interval)
+		{
+			return disscalc::compute_dissonance<TestType>(
+				stable,
+				mobile,
+				interval
+			);
+		}
+	);
+	REQUIRE(error.sample_count == intervals.size());
+	REQUIRE(error.max_relative < 0.005);
+}
+
+TEST_CASE("Empty timbres have no dissonance with FFTs", "[fft-engine]")
+{
+	std::vector<disscalc::Partial> const stable = {{440.0, 1.0}};
+	std::vector<double> const intervals = {1.0, 1.5};
+
+	auto const curve = disscalc::compute_dissonance_curve_fft<
+		disscalc::SetharesModel
+	>(stable, {}, intervals);
+	REQUIRE(curve == std::vector{0.0, 0.0});
+}
@@ -0,0 +1,92 @@
+#include "disscalc/bounded-queue.hpp"
+#include "disscalc/frames.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Parse timbre lines", "[frames]")
+{
+	auto const partials = disscalc::parse_timbre_line(" 220 1\t440 0.5 ");
+	REQUIRE(partials.has_value());
+	REQUIRE(partials->size() == 2);
+	REQUIRE((*partials)[1].frequency == 440.0);
+	REQUIRE((*partials)[1].amplitude == 0.5);
+
+	REQUIRE(disscalc::parse_timbre_line("")->empty());
+	REQUIRE(!disscalc::parse_timbre_line("220 1 440").has_value());
+	REQUIRE(!disscalc::parse_timbre_line("220 -1").has_value());
+	REQUIRE(!disscalc::parse_timbre_line("220 1x").has_value());
+}
+
+TEST_CASE("Read timbre frames", "[frames]")
+{
+	std::istringstream in("# comment\n220 1\n\n230 1 460 0.5\n1 2 3\n240 1\n");
+	disscalc::TimbreFrameReader reader(in);
+
+	auto const first = reader.next();
+	REQUIRE(first.has_value());
+	REQUIRE(first->index == 0);
+	REQUIRE(first->partials.size() == 1);
+
+	auto const second = reader.next();
+	REQUIRE(second.has_value());
+	REQUIRE(second->index == 1);
+	REQUIRE(second->partials.size() == 2);
+
+	// Reading stops at the malformed line.
+	REQUIRE(!reader.next().has_value());
+	REQUIRE(reader.error_line() == 5);
+	REQUIRE(!reader.next().has_value());
+}
+
+TEST_CASE("Compare and summarize frames", "[frames]")
+{
+	std::vector<disscalc::Partial> const a = {{220.0, 1.0}, {440.0, 0.5}};
+	std::vector<disscalc::Partial> const b = {{221.0, 1.0}, {440.0, 0.5}};
+
+	REQUIRE(disscalc::timbres_are_similar(a, a, 0.0));
+	REQUIRE(disscalc::timbres_are_similar(a, b, 0.01));
+	REQUIRE(!disscalc::timbres_are_similar(a, b, 0.001));
+	REQUIRE(!disscalc::timbres_are_similar(a, {a.data(), 1}, 1.0));
+
+	std::vector<disscalc::TableRow> const rows = {
+		{1.0, 0.0, false},
+		{1.1, 3.0, false},
+		{1.2, 1.0, false},
+		{1.3, 2.0, false},
+		{1.4, 2.0, false},
+		{1.5, 0.5, false},
+	};
+	auto const minima = disscalc::find_local_minima(rows);
+	REQUIRE(minima.size() == 1);
+	REQUIRE(minima[0].input == 1.2);
+}
+
+TEST_CASE("Pass items through a bounded queue", "[frames]")
+{
+	disscalc::BoundedQueue<int> queue(2);
+
+	// Catch assertions are not thread safe, so the result is checked later.
+	bool pushed_all = true;
+	std::jthread producer([&]
+	{
+		for (int i = 0; i < 100; ++i)
+		{
+			pushed_all = queue.push(i) && pushed_all;
+		}
+		queue.close();
+	});
+
+	int expected = 0;
+	while (auto const item = queue.pop())
+	{
+		REQUIRE(*item == expected++);
+	}
+	producer.join();
+	REQUIRE(expected == 100);
+	REQUIRE(pushed_all);
+	REQUIRE(!queue.push(100));
+}
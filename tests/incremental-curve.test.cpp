@@ -0,0 +1,101 @@
+#include "disscalc/dissonance.hpp"
+#include "disscalc/incremental-curve.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+// Check that `curve` is close to the curve computed from its partials.
+template <disscalc::DissonanceModelPolicy Model>
+static
+void check_incremental_curve(disscalc::IncrementalCurve<Model> const& curve)
+{
+	auto const stable = curve.partials(disscalc::TimbreSide::stable);
+	auto const mobile = curve.partials(disscalc::TimbreSide::mobile);
+	for (std::size_t i = 0; i < curve.intervals().size(); ++i)
+	{
+		REQUIRE(
+			curve.dissonances()[i]
+			== Approx(disscalc::compute_dissonance<Model>(
+				stable,
+				mobile,
+				curve.intervals()[i]
+			)).margin(1e-12)
+		);
+	}
+}
+
+TEMPLATE_TEST_CASE(
+	"Update curves as partials change",
+	"[incremental-curve]",
+	disscalc::SetharesModel,
+	disscalc::ProductModel,
+	disscalc::VassilakisModel
+)
+{
+	using disscalc::TimbreSide;
+
+	std::vector<double> intervals;
+	for (int i = 0; i <= 100; ++i)
+	{
+		intervals.push_back(1.0 + 0.01 * i);
+	}
+
+	disscalc::IncrementalCurve<TestType> separate(
+		{{220.0, 1.0}, {440.0, 0.5}},
+		{{230.0, 0.8}},
+		intervals,
+		3
+	);
+	separate.add_partial(TimbreSide::stable, {660.0, 0.3});
+	separate.add_partial(TimbreSide::mobile, {461.0, 0.4});
+	separate.set_partial(TimbreSide::mobile, 0, {225.0, 0.9});
+	separate.remove_partial(TimbreSide::stable, 1);
+	REQUIRE(separate.partials(TimbreSide::stable).size() == 2);
+	REQUIRE(separate.partials(TimbreSide::stable)[1].frequency == 660.0);
+	REQUIRE(separate.updates_since_rebuild() == 4);
+	check_incremental_curve(separate);
+
+	// Both sides of a shared timbre are the same partials.
+	disscalc::IncrementalCurve<TestType> shared(
+		{{220.0, 1.0}, {330.0, 0.7}},
+		intervals
+	);
+	shared.add_partial(TimbreSide::mobile, {440.0, 0.5});
+	shared.set_partial(TimbreSide::stable, 0, {221.0, 0.9});
+	shared.remove_partial(TimbreSide::stable, 1);
+	REQUIRE(shared.partials(TimbreSide::mobile).size() == 2);
+	check_incremental_curve(shared);
+
+	// Rebuilding gives exactly the full computation.
+	shared.rebuild();
+	REQUIRE(shared.updates_since_rebuild() == 0);
+	auto const partials = shared.partials(TimbreSide::stable);
+	for (std::size_t i = 0; i < intervals.size(); ++i)
+	{
+		REQUIRE(
+			shared.dissonances()[i]
+			== disscalc::compute_dissonance<TestType>(
+				partials,
+				partials,
+				intervals[i]
+			)
+		);
+	}
+}
+
+TEST_CASE("Rebuild curves periodically", "[incremental-curve]")
+{
+	disscalc::IncrementalCurve<disscalc::SetharesModel> curve(
+		{{220.0, 1.0}},
+		{1.0, 1.5},
+		1,
+		3
+	);
+	curve.add_partial(disscalc::TimbreSide::stable, {440.0, 0.5});
+	curve.add_partial(disscalc::TimbreSide::stable, {660.0, 0.3});
+	REQUIRE(curve.updates_since_rebuild() == 2);
+	curve.remove_partial(disscalc::TimbreSide::stable, 0);
+	REQUIRE(curve.updates_since_rebuild() == 0);
+	check_incremental_curve(curve);
+}
@@ -0,0 +1,78 @@
+#include "disscalc/interval-grid.hpp"
+#include "disscalc/table.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <vector>
+
+static_assert(std::ranges::random_access_range<disscalc::IntervalGrid const&>);
+static_assert(std::ranges::sized_range<disscalc::IntervalGrid const&>);
+
+TEST_CASE("Interval grids include their upper bound", "[interval-grid]")
+{
+	// Adding the delta repeatedly would land just above the upper bound.
+	disscalc::IntervalGrid const coarse(1.0, 0.05, 2.0, {});
+	REQUIRE(coarse.size() == 21);
+	REQUIRE(coarse[20].value == Approx(2.0));
+
+	disscalc::IntervalGrid const fine(1.0, 0.01, 2.0, {});
+	REQUIRE(fine.size() == 101);
+	for (std::size_t i = 0; i < fine.size(); ++i)
+	{
+		REQUIRE(fine[i].value == 1.0 + static_cast<double>(i) * 0.01);
+		REQUIRE_FALSE(fine[i].is_extra);
+	}
+
+	REQUIRE(disscalc::IntervalGrid(1.0, 0.3, 2.0, {}).size() == 4);
+	REQUIRE(disscalc::IntervalGrid(2.0, 0.1, 1.0, {}).size() == 0);
+	REQUIRE(disscalc::IntervalGrid(2.0, 0.1, 1.0, {1.5}).size() == 1);
+}
+
+TEST_CASE("Read interval grids in any order", "[interval-grid]")
+{
+	disscalc::IntervalGrid const grid(1.0, 0.25, 2.0, {0.5, 1.25, 1.3, 2.5});
+	std::vector<double> const values
+		= {0.5, 1.0, 1.25, 1.3, 1.5, 1.75, 2.0, 2.5};
+	std::vector<bool> const extras
+		= {true, false, false, true, false, false, false, true};
+
+	REQUIRE(grid.size() == values.size());
+	REQUIRE(grid.step_count() == 5);
+	for (std::size_t i = values.size(); i-- > 0;)
+	{
+		REQUIRE(grid[i].value == values[i]);
+		REQUIRE(grid[i].is_extra == extras[i]);
+	}
+
+	auto const middle = grid.rows({2, 5});
+	REQUIRE(std::ranges::size(middle) == 3);
+	REQUIRE(middle[0].value == 1.25);
+	REQUIRE(middle[2].value == 1.5);
+	REQUIRE(std::begin(middle).row() == 2);
+
+	REQUIRE(std::ranges::empty(grid.rows({7, 3})));
+	REQUIRE(std::ranges::size(grid.rows(disscalc::all_rows)) == grid.size());
+}
+
+TEST_CASE("Compute table rows lazily", "[interval-grid]")
+{
+	disscalc::IntervalGrid const grid(1.0, 0.5, 3.0, {});
+	std::size_t calls = 0;
+	auto const rows = disscalc::table_rows(grid, [&](double x) noexcept
+	{
+		++calls;
+		return 2.0 * x;
+	});
+	static_assert(std::ranges::random_access_range<decltype(rows)>);
+
+	REQUIRE(std::ranges::size(rows) == 5);
+	REQUIRE(calls == 0);
+
+	auto const row = rows[3];
+	REQUIRE(row.input == 2.5);
+	REQUIRE(row.output == 5.0);
+	REQUIRE(calls == 1);
+}
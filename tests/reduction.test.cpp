@@ -0,0 +1,87 @@
+#include "disscalc/dissonance.hpp"
+#include "disscalc/reduction.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+// Create a harmonic timbre with near-duplicate partials and faint noise.
+[[nodiscard]] static
+auto make_cluttered_timbre(std::mt19937& rng) -> std::vector<disscalc::Partial>
+{
+	std::uniform_real_distribution<double> detune(-0.001, 0.001);
+	std::uniform_real_distribution<double> noise_freq(100.0, 5000.0);
+	std::uniform_real_distribution<double> noise_amp(1e-5, 1e-3);
+
+	std::vector<disscalc::Partial> partials;
+	for (int k = 1; k <= 20; ++k)
+	{
+		partials.push_back({220.0 * k * (1.0 + detune(rng)), 1.0 / k});
+		partials.push_back({220.0 * k * 1.0008, 0.3 / k});
+	}
+	for (int i = 0; i < 60; ++i)
+	{
+		partials.push_back({noise_freq(rng), noise_amp(rng)});
+	}
+	return partials;
+}
+
+TEMPLATE_TEST_CASE(
+	"Reduced partials stay within the error bound",
+	"[reduction]",
+	disscalc::SetharesModel,
+	disscalc::ProductModel,
+	disscalc::VassilakisModel
+)
+{
+	std::mt19937 rng(29);
+	auto const stable = make_cluttered_timbre(rng);
+	auto const mobile = make_cluttered_timbre(rng);
+	double const max_error = 0.05;
+
+	for (bool const shared : {true, false})
+	{
+		auto reduced_stable = stable;
+		auto reduced_mobile = shared ? stable : mobile;
+		auto const report = disscalc::reduce_partials<TestType>(
+			reduced_stable,
+			reduced_mobile,
+			shared,
+			{0.9, 2.1},
+			max_error
+		);
+
+		REQUIRE(report.error_bound <= max_error);
+		REQUIRE(report.stable_after == reduced_stable.size());
+		REQUIRE(report.mobile_after == reduced_mobile.size());
+
+		// The near-duplicate partials and faint noise must be removed.
+		auto const& original_mobile = shared ? stable : mobile;
+		REQUIRE(reduced_stable.size() < stable.size());
+		REQUIRE(reduced_mobile.size() < original_mobile.size());
+		REQUIRE(report.stable_before == stable.size());
+		REQUIRE(report.mobile_before == original_mobile.size());
+
+		double greatest_error = 0.0;
+		for (double interval = 0.9; interval <= 2.1; interval += 0.0025)
+		{
+			double const exact = disscalc::compute_dissonance<TestType>(
+				stable,
+				original_mobile,
+				interval
+			);
+			double const approximate =
+				disscalc::compute_dissonance<TestType>(
+					reduced_stable,
+					reduced_mobile,
+					interval
+				);
+			greatest_error =
+				std::max(greatest_error, std::abs(exact - approximate));
+		}
+		REQUIRE(greatest_error <= report.error_bound);
+	}
+}
@@ -0,0 +1,80 @@
+#include "disscalc/scales.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <sstream>
+
+TEST_CASE("Create equal temperaments", "[scales]")
+{
+	auto const edo = disscalc::make_edo_scale(12);
+
+	REQUIRE(edo.name == "12-EDO");
+	REQUIRE(edo.steps() == 12);
+	REQUIRE(edo.pitches.front() == Approx(1.0));
+	REQUIRE(edo.pitches[7] == Approx(std::exp2(7.0 / 12.0)));
+	REQUIRE(edo.pitches.back() == Approx(2.0));
+}
+
+TEST_CASE("Read Scala files", "[scales]")
+{
+	std::istringstream s0(
+		"! comment\n"
+		"Description\n"
+		"!\n"
+		" 3\n"
+		" 5/4\n"
+		"701.955 fifth\n"
+		"2\n"
+	);
+	auto const scale = disscalc::read_scala_scale(s0, "test");
+	REQUIRE(scale.has_value());
+	REQUIRE(scale->name == "test");
+	REQUIRE(scale->steps() == 3);
+	REQUIRE(scale->pitches[0] == Approx(1.0));
+	REQUIRE(scale->pitches[1] == Approx(1.25));
+	REQUIRE(scale->pitches[2] == Approx(1.5));
+	REQUIRE(scale->pitches[3] == Approx(2.0));
+
+	// Fewer pitches than declared.
+	std::istringstream s1("Description\n3\n5/4\n2/1\n");
+	REQUIRE(!disscalc::read_scala_scale(s1, "").has_value());
+
+	std::istringstream s2("Description\n1\n3/-2\n");
+	REQUIRE(!disscalc::read_scala_scale(s2, "").has_value());
+
+	std::istringstream s3("Description\nthree\n");
+	REQUIRE(!disscalc::read_scala_scale(s3, "").has_value());
+}
+
+TEST_CASE("Evaluate scales", "[scales]")
+{
+	// Dissonance of an interval is its step count in a 4-EDO.
+	auto const steps_of = [](double interval)
+	{
+		return std::round(std::log2(interval) * 4.0);
+	};
+
+	std::size_t evaluations = 0;
+	auto const pairs = disscalc::compute_pair_dissonances(
+		disscalc::make_edo_scale(4),
+		[&](double interval)
+		{
+			++evaluations;
+			return steps_of(interval);
+		}
+	);
+	REQUIRE(evaluations == 4);
+	REQUIRE(pairs(0, 4) == Approx(4.0));
+	REQUIRE(pairs(3, 1) == Approx(2.0));
+
+	auto const evaluation = disscalc::summarize_scale(pairs, 5);
+	REQUIRE(evaluation.total == Approx(20.0));
+	REQUIRE(evaluation.per_step == Approx(5.0));
+	REQUIRE(evaluation.least_chord_dissonances.size() == 3);
+	REQUIRE(evaluation.least_chord_dissonances[0] == Approx(4.0));
+	REQUIRE(evaluation.least_chord_dissonances[1] == Approx(10.0));
+
+	// Not enough notes in a period for a five-note chord.
+	REQUIRE(std::isnan(evaluation.least_chord_dissonances[2]));
+}
@@ -0,0 +1,299 @@
+#include "disscalc/checkpoint.hpp"
+#include "disscalc/decimation.hpp"
+#include "disscalc/table.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("Enumerate table inputs", "[table]")
+{
+	std::vector<double> inputs;
+	std::vector<bool> extras;
+	disscalc::for_each_table_input(
+		1.0,
+		0.5,
+		2.0,
+		{0.25, 1.5, 1.75, 3.0},
+		[&](double x, bool is_extra)
+		{
+			inputs.push_back(x);
+			extras.push_back(is_extra);
+		}
+	);
+
+	REQUIRE(inputs == std::vector<double>{0.25, 1.0, 1.5, 1.75, 2.0, 3.0});
+	REQUIRE(extras == std::vector<bool>{true, false, false, true, false, true});
+	REQUIRE(disscalc::count_table_rows(1.0, 0.5, 2.0, {0.25, 1.5}) == 4);
+}
+
+TEST_CASE("Split tables into shards", "[table]")
+{
+	// Shards are contiguous and cover every row exactly once.
+	for (std::size_t shard_count = 1; shard_count <= 12; ++shard_count)
+	{
+		std::size_t next_row = 0;
+		for (std::size_t shard = 0; shard < shard_count; ++shard)
+		{
+			auto const rows = disscalc::get_shard_rows(10, shard, shard_count);
+			REQUIRE(rows.first == next_row);
+			REQUIRE(rows.last - rows.first <= 10 / shard_count + 1);
+			next_row = rows.last;
+		}
+		REQUIRE(next_row == 10);
+	}
+
+	std::ostringstream whole;
+	disscalc::print_table_as_dsv(
+		whole,
+		1.0,
+		0.25,
+		2.0,
+		[](double x) { return x * 2.0; },
+		',',
+		{0.5, 1.1}
+	);
+
+	std::ostringstream sharded;
+	for (std::size_t shard = 0; shard < 3; ++shard)
+	{
+		disscalc::print_table_as_dsv(
+			sharded,
+			1.0,
+			0.25,
+			2.0,
+			[](double x) { return x * 2.0; },
+			',',
+			{0.5, 1.1},
+			disscalc::get_shard_rows(7, shard, 3),
+			[](std::size_t) {}
+		);
+	}
+	REQUIRE(sharded.str() == whole.str());
+}
+
+TEST_CASE("Visit tables progressively", "[table]")
+{
+	for (std::size_t row_count : {0, 1, 2, 17, 18, 100, 1025})
+	{
+		std::vector<std::size_t> visits(row_count, 0);
+		std::size_t expected_level = 0;
+		disscalc::for_each_progressive_level(
+			row_count,
+			[&](std::size_t level, std::span<std::size_t const> rows)
+			{
+				REQUIRE(level == expected_level++);
+				REQUIRE(std::ranges::is_sorted(rows));
+				if (level == 0)
+				{
+					REQUIRE(
+						rows.size()
+						<= disscalc::progressive_first_level_intervals + 1
+					);
+					REQUIRE(rows.front() == 0);
+					REQUIRE(rows.back() == row_count - 1);
+				}
+				for (auto const row : rows)
+				{
+					++visits[row];
+				}
+			}
+		);
+		REQUIRE(std::ranges::count(visits, 1) == row_count);
+	}
+}
+
+TEST_CASE("Print tables spanning many blocks", "[table]")
+{
+	auto const row_count = 3 * disscalc::table_block_size + 5;
+
+	std::ostringstream out;
+	std::vector<std::size_t> printed;
+	disscalc::print_table_as_dsv(
+		out,
+		0.0,
+		1.0,
+		static_cast<double>(row_count - 1),
+		[](double x) { return -x; },
+		',',
+		{},
+		{2, row_count},
+		[&](std::size_t index)
+		{
+			// Called on the printing thread, which is joined before returning.
+			printed.push_back(index);
+		}
+	);
+
+	std::vector<std::size_t> expected_indices(row_count - 2);
+	std::iota(expected_indices.begin(), expected_indices.end(), 2);
+	REQUIRE(printed == expected_indices);
+
+	std::ostringstream expected;
+	for (auto const index : expected_indices)
+	{
+		auto const x = static_cast<double>(index);
+		disscalc::print_table_entry(expected, x, -x, ',');
+	}
+	REQUIRE(out.str() == expected.str());
+}
+
+TEST_CASE("Propagate exceptions while printing tables", "[table]")
+{
+	auto const row_count = 2 * disscalc::table_block_size;
+
+	std::ostringstream out;
+	auto const print = [&]
+	{
+		disscalc::print_table_as_dsv(
+			out,
+			0.0,
+			1.0,
+			static_cast<double>(row_count - 1),
+			[&](double x)
+			{
+				if (x > static_cast<double>(disscalc::table_block_size))
+				{
+					throw std::runtime_error("row failed");
+				}
+				return x;
+			},
+			',',
+			{}
+		);
+	};
+
+	// The printer thread must not be left waiting for more rows.
+	REQUIRE_THROWS_AS(print(), std::runtime_error);
+}
+
+TEST_CASE("Read and write checkpoints", "[table]")
+{
+	std::stringstream stream;
+	disscalc::write_checkpoint(stream, {0xDEADBEEF12345678, 1234, 98765});
+
+	auto const checkpoint = disscalc::read_checkpoint(stream);
+	REQUIRE(checkpoint.has_value());
+	REQUIRE(checkpoint->fingerprint == 0xDEADBEEF12345678);
+	REQUIRE(checkpoint->completed_rows == 1234);
+	REQUIRE(checkpoint->output_size == 98765);
+
+	std::istringstream malformed("disscalc-checkpoint 1\nrows 5\n");
+	REQUIRE(!disscalc::read_checkpoint(malformed).has_value());
+
+	std::vector<char const*> a = {"disscalc", "-p", "1"};
+	std::vector<char const*> b = {"other/disscalc", "-p", "1"};
+	std::vector<char const*> c = {"disscalc", "-p1"};
+	REQUIRE(
+		disscalc::fingerprint_arguments(a) == disscalc::fingerprint_arguments(b)
+	);
+	REQUIRE(
+		disscalc::fingerprint_arguments(a) != disscalc::fingerprint_arguments(c)
+	);
+
+	// Inputs read from files must be part of the fingerprint.
+	auto const args = disscalc::fingerprint_arguments(a);
+	std::vector<disscalc::Partial> const stable = {{100.0, 1.0}, {200.0, 0.5}};
+	std::vector<disscalc::Partial> const quieter = {{100.0, 1.0}, {200.0, 0.4}};
+	std::vector<double> const extra = {1.5};
+	auto const inputs =
+		disscalc::fingerprint_inputs(args, stable, stable, extra);
+	REQUIRE(
+		inputs == disscalc::fingerprint_inputs(args, stable, stable, extra)
+	);
+	REQUIRE(
+		inputs != disscalc::fingerprint_inputs(args, stable, quieter, extra)
+	);
+	REQUIRE(inputs != disscalc::fingerprint_inputs(args, stable, stable, {}));
+	REQUIRE(
+		disscalc::fingerprint_inputs(args, stable, {}, extra)
+			!= disscalc::fingerprint_inputs(args, {}, stable, extra)
+	);
+}
+
+TEST_CASE("Decimate tables", "[table]")
+{
+	std::vector<disscalc::TableRow> rows;
+	for (int i = 0; i <= 1000; ++i)
+	{
+		double const x = i / 100.0;
+		rows.push_back({x, std::sin(x) + (i == 500 ? 0.5 : 0.0), i == 250});
+	}
+
+	double const tolerance = 0.01;
+	std::vector<disscalc::TableRow> kept;
+	disscalc::Decimator decimator(
+		tolerance,
+		[&](disscalc::TableRow const& row) { kept.push_back(row); }
+	);
+	for (auto const& row : rows)
+	{
+		decimator.add(row);
+	}
+	decimator.finish();
+
+	REQUIRE(kept.size() < rows.size() / 10);
+	REQUIRE(kept.front().input == rows.front().input);
+	REQUIRE(kept.back().input == rows.back().input);
+
+	auto const is_kept = [&](double x)
+	{
+		return std::ranges::find(kept, x, &disscalc::TableRow::input)
+			!= std::end(kept);
+	};
+
+	// Extra values, the spike and the extrema of the sine are all kept.
+	REQUIRE(is_kept(2.5));
+	REQUIRE(is_kept(5.0));
+	REQUIRE(is_kept(1.57));
+	REQUIRE(is_kept(4.71));
+	REQUIRE(is_kept(7.85));
+
+	// Every dropped row is reproduced by interpolation.
+	std::size_t segment = 0;
+	for (auto const& row : rows)
+	{
+		while (kept[segment + 1].input < row.input)
+		{
+			++segment;
+		}
+		auto const& left = kept[segment];
+		auto const& right = kept[segment + 1];
+		double const interpolated = left.output
+			+ (right.output - left.output)
+				* (row.input - left.input) / (right.input - left.input);
+		REQUIRE(std::abs(interpolated - row.output) <= tolerance + 1e-12);
+	}
+}
+
+TEST_CASE("Decimate tables with extra values past the range", "[table]")
+{
+	std::vector<disscalc::TableRow> kept;
+	disscalc::Decimator decimator(
+		100.0,
+		[&](disscalc::TableRow const& row) { kept.push_back(row); }
+	);
+	disscalc::for_each_table_row(
+		1.0,
+		0.1,
+		1.2,
+		[](double) noexcept { return 0.0; },
+		{1.25},
+		disscalc::all_rows,
+		[&](std::size_t, disscalc::TableRow const& row)
+		{
+			decimator.add(row);
+		}
+	);
+	decimator.finish();
+
+	REQUIRE(kept.size() == 3);
+	REQUIRE(kept[1].input == Approx(1.2));
+	REQUIRE(kept[2].input == 1.25);
+	REQUIRE(std::ranges::is_sorted(kept, {}, &disscalc::TableRow::input));
+}
@@ -0,0 +1,106 @@
+#include "disscalc/timbre-extraction.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <sstream>
+#include <string>
+
+// Append a little-endian integer of `size` bytes to `out`.
+static
+void append_little_endian(std::string& out, std::uint32_t value, int size)
+{
+	for (int i = 0; i < size; ++i)
+	{
+		out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+	}
+}
+
+/*
+ * Create a 16-bit stereo WAV file of two sines, with an unrelated chunk before
+ * the format.
+ */
+[[nodiscard]] static
+std::string make_test_wav(std::uint32_t sample_rate, std::uint32_t frames)
+{
+	std::string data;
+	for (std::uint32_t i = 0; i < frames; ++i)
+	{
+		double const t = static_cast<double>(i) / sample_rate;
+		double const sample = 0.5 * std::sin(2 * std::numbers::pi * 440.0 * t)
+			+ 0.25 * std::sin(2 * std::numbers::pi * 1320.0 * t);
+		auto const value = static_cast<std::int16_t>(sample * 32767.0);
+		for (int channel = 0; channel < 2; ++channel)
+		{
+			append_little_endian(data, static_cast<std::uint16_t>(value), 2);
+		}
+	}
+
+	std::string wav = "RIFF";
+	append_little_endian(
+		wav,
+		static_cast<std::uint32_t>(4 + 14 + 24 + 8 + data.size()),
+		4
+	);
+	wav += "WAVE";
+	wav += "LIST";
+	append_little_endian(wav, 5, 4);
+	wav += "abcde";
+	wav.push_back('\0');
+	wav += "fmt ";
+	append_little_endian(wav, 16, 4);
+	append_little_endian(wav, 1, 2);
+	append_little_endian(wav, 2, 2);
+	append_little_endian(wav, sample_rate, 4);
+	append_little_endian(wav, sample_rate * 4, 4);
+	append_little_endian(wav, 4, 2);
+	append_little_endian(wav, 16, 2);
+	wav += "data";
+	append_little_endian(wav, static_cast<std::uint32_t>(data.size()), 4);
+	wav += data;
+	return wav;
+}
+
+TEST_CASE("Extract timbres from WAV files", "[timbre-extraction]")
+{
+	std::istringstream wav(make_test_wav(44100, 44100));
+	auto const partials = disscalc::extract_timbre_from_wav(
+		wav,
+		4096,
+		{-40.0, 8}
+	);
+
+	REQUIRE(partials.has_value());
+	REQUIRE(partials->size() == 2);
+	REQUIRE((*partials)[0].frequency == Approx(440.0).epsilon(0.002));
+	REQUIRE((*partials)[0].amplitude == Approx(1.0));
+	REQUIRE((*partials)[1].frequency == Approx(1320.0).epsilon(0.002));
+	REQUIRE((*partials)[1].amplitude == Approx(0.5).epsilon(0.05));
+
+	std::istringstream not_wav("RIFF....AVI ");
+	REQUIRE(!disscalc::extract_timbre_from_wav(not_wav, 4096, {}).has_value());
+}
+
+TEST_CASE("Limit the number of spectral peaks", "[timbre-extraction]")
+{
+	std::vector<double> const magnitudes = {0, 1, 0.5, 4, 0.5, 2, 0.5, 0};
+
+	auto const partials = disscalc::find_spectral_peaks(
+		magnitudes,
+		10.0,
+		{-100.0, 2}
+	);
+	REQUIRE(partials.size() == 2);
+	REQUIRE(partials[0].frequency == Approx(30.0));
+	REQUIRE(partials[0].amplitude == Approx(1.0));
+	REQUIRE(partials[1].frequency == Approx(50.0));
+
+	auto const loud = disscalc::find_spectral_peaks(
+		magnitudes,
+		10.0,
+		{-3.0, 0}
+	);
+	REQUIRE(loud.size() == 1);
+}
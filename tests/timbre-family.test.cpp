@@ -0,0 +1,109 @@
+#include "disscalc/dissonance.hpp"
+#include "disscalc/output.hpp"
+#include "disscalc/timbre-family.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+static std::vector<disscalc::Partial> const base_timbre = {
+	{220.0, 1.0},
+	{440.0, 0.5},
+	{880.0, 0.25},
+};
+
+TEST_CASE("Apply timbre parameters", "[timbre-family]")
+{
+	using disscalc::TimbreParameter;
+
+	// Each parameter has a value that leaves the timbre unchanged.
+	for (auto const [parameter, identity] : {
+		std::pair(TimbreParameter::stretch, 2.0),
+		std::pair(TimbreParameter::rolloff, 0.0),
+		std::pair(TimbreParameter::inharmonicity, 0.0),
+	})
+	{
+		auto const partials = disscalc::apply_timbre_parameter(
+			base_timbre,
+			parameter,
+			identity
+		);
+		REQUIRE(partials.size() == base_timbre.size());
+		for (std::size_t i = 0; i < partials.size(); ++i)
+		{
+			REQUIRE(partials[i].frequency == Approx(base_timbre[i].frequency));
+			REQUIRE(partials[i].amplitude == Approx(base_timbre[i].amplitude));
+		}
+	}
+
+	auto const stretched = disscalc::apply_timbre_parameter(
+		base_timbre,
+		TimbreParameter::stretch,
+		2.1
+	);
+	REQUIRE(stretched[0].frequency == Approx(220.0));
+	REQUIRE(stretched[1].frequency == Approx(462.0));
+	REQUIRE(stretched[2].frequency == Approx(220.0 * 2.1 * 2.1));
+
+	auto const rolled_off = disscalc::apply_timbre_parameter(
+		base_timbre,
+		TimbreParameter::rolloff,
+		1.0
+	);
+	REQUIRE(rolled_off[0].amplitude == Approx(1.0));
+	REQUIRE(rolled_off[2].amplitude == Approx(0.25 / 4.0));
+}
+
+TEST_CASE("Compute dissonances of a timbre family", "[timbre-family]")
+{
+	disscalc::ParameterSweep const sweep{
+		disscalc::TimbreParameter::stretch,
+		1.9,
+		2.1,
+		3
+	};
+	std::vector<double> const intervals = {1.0, 1.25, 1.5, 2.0};
+
+	auto const matrix = disscalc::compute_timbre_family(
+		base_timbre,
+		{},
+		sweep,
+		intervals,
+		2,
+		[](auto const& stable, auto const& mobile, double d) noexcept
+		{
+			return disscalc::compute_dissonance(stable, mobile, d);
+		}
+	);
+
+	REQUIRE(matrix.parameters == std::vector<double>{1.9, 2.0, 2.1});
+	REQUIRE(matrix.values.size() == 12);
+	for (std::size_t column = 0; column < intervals.size(); ++column)
+	{
+		REQUIRE(
+			matrix.at(1, column)
+			== disscalc::compute_dissonance(
+				base_timbre,
+				base_timbre,
+				intervals[column]
+			)
+		);
+	}
+
+	std::ostringstream text;
+	disscalc::print_matrix_as_dsv(text, matrix, ',');
+	REQUIRE(text.str().starts_with(",1,1.25,1.5,2\n1.9,"));
+
+	std::ostringstream binary;
+	disscalc::write_matrix_as_binary(binary, matrix);
+	auto const bytes = binary.str();
+	REQUIRE(bytes.size() == 8 * (2 + 4 + 3 + 12));
+	REQUIRE(bytes[0] == 3);
+	REQUIRE(bytes[8] == 4);
+
+	double last;
+	std::memcpy(&last, bytes.data() + bytes.size() - 8, sizeof(last));
+	REQUIRE(last == matrix.at(2, 3));
+}
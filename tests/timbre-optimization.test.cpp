@@ -0,0 +1,170 @@
+#include "disscalc/dissonance.hpp"
+#include "disscalc/scales.hpp"
+#include "disscalc/timbre-optimization.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <vector>
+
+TEST_CASE("Count the intervals of a scale", "[timbre-optimization]")
+{
+	auto const scale = disscalc::make_edo_scale(12);
+	auto const intervals = disscalc::find_scale_intervals(scale);
+
+	// Each of 12 steps, spanned by fewer pairs the wider it is.
+	REQUIRE(intervals.size() == 12);
+	for (std::size_t i = 0; i < intervals.size(); ++i)
+	{
+		REQUIRE(intervals[i].count == static_cast<double>(12 - i));
+	}
+
+	std::vector<disscalc::Partial> const timbre = {{300.0, 1.0}, {610.0, 0.4}};
+	auto const dissonance_at = [&](double interval) noexcept
+	{
+		return disscalc::compute_dissonance(timbre, timbre, interval);
+	};
+	double total = 0.0;
+	for (auto const [interval, count] : intervals)
+	{
+		total += count * dissonance_at(interval);
+	}
+	auto const evaluation = disscalc::evaluate_scale(scale, dissonance_at, 2);
+	REQUIRE(total == Approx(evaluation.total));
+}
+
+TEMPLATE_TEST_CASE(
+	"Timbre gradients match finite differences",
+	"[timbre-optimization]",
+	disscalc::SetharesModel,
+	disscalc::ProductModel,
+	disscalc::VassilakisModel
+)
+{
+	std::vector<disscalc::Partial> const timbre = {
+		{261.0, 1.0},
+		{527.0, 0.6},
+		{781.0, 0.35},
+		{1049.0, 0.2},
+	};
+	std::vector<disscalc::WeightedInterval> const intervals = {
+		{1.06, 3.0},
+		{1.26, 1.0},
+		{1.5, 2.0},
+	};
+
+	auto const total_of = [&](std::vector<disscalc::Partial> const& partials)
+	{
+		double total = 0.0;
+		for (auto const [interval, count] : intervals)
+		{
+			total += count * disscalc::compute_dissonance<TestType>(
+				partials,
+				partials,
+				interval
+			);
+		}
+		return total;
+	};
+
+	auto const result = disscalc::compute_timbre_dissonance<TestType>(
+		timbre,
+		intervals,
+		2
+	);
+	REQUIRE(result.total == Approx(total_of(timbre)));
+
+	for (std::size_t i = 0; i < timbre.size(); ++i)
+	{
+		constexpr double frequency_step = 1e-4;
+		auto higher = timbre;
+		auto lower = timbre;
+		higher[i].frequency += frequency_step;
+		lower[i].frequency -= frequency_step;
+		double const frequency_slope = (total_of(higher) - total_of(lower))
+			/ (2.0 * frequency_step);
+		REQUIRE(
+			result.frequency_slopes[i]
+			== Approx(frequency_slope).epsilon(1e-5).margin(1e-9)
+		);
+
+		constexpr double amplitude_step = 1e-6;
+		higher = timbre;
+		lower = timbre;
+		higher[i].amplitude += amplitude_step;
+		lower[i].amplitude -= amplitude_step;
+		double const amplitude_slope = (total_of(higher) - total_of(lower))
+			/ (2.0 * amplitude_step);
+		REQUIRE(
+			result.amplitude_slopes[i]
+			== Approx(amplitude_slope).epsilon(1e-5).margin(1e-9)
+		);
+	}
+}
+
+TEST_CASE("Optimize timbres within bounds", "[timbre-optimization]")
+{
+	std::vector<disscalc::Partial> const start = {
+		{261.63, 1.0},
+		{523.26, 0.5},
+		{784.89, 0.33},
+		{1046.52, 0.25},
+	};
+	auto const intervals = disscalc::find_scale_intervals(
+		disscalc::make_edo_scale(12)
+	);
+
+	disscalc::TimbreOptimizationSettings settings;
+	settings.parameters = disscalc::OptimizedParameters::both;
+	settings.frequency_range = 30.0;
+	settings.amplitude_range = 1.5;
+	settings.max_iterations = 40;
+
+	using Model = disscalc::SetharesModel;
+	auto const optimization = disscalc::optimize_timbre<Model>(
+		start,
+		intervals,
+		settings,
+		1
+	);
+	REQUIRE(optimization.final_dissonance < optimization.initial_dissonance);
+	REQUIRE(optimization.iterations <= settings.max_iterations);
+
+	double start_sum = 0.0;
+	double optimized_sum = 0.0;
+	for (std::size_t i = 0; i < start.size(); ++i)
+	{
+		auto const partial = optimization.partials[i];
+		double const cents = 1200.0
+			* std::abs(std::log2(partial.frequency / start[i].frequency));
+		REQUIRE(cents <= settings.frequency_range + 1e-9);
+		REQUIRE(partial.amplitude >= start[i].amplitude / 1.5 - 1e-12);
+		REQUIRE(partial.amplitude <= start[i].amplitude * 1.5 + 1e-12);
+
+		start_sum += start[i].amplitude;
+		optimized_sum += partial.amplitude;
+	}
+	REQUIRE(optimized_sum == Approx(start_sum));
+
+	// Candidates are evaluated in parallel without changing the result.
+	auto const parallel = disscalc::optimize_timbre<Model>(
+		start,
+		intervals,
+		settings,
+		3
+	);
+	REQUIRE(parallel.final_dissonance == optimization.final_dissonance);
+
+	// Only the chosen parameters are adjusted.
+	settings.parameters = disscalc::OptimizedParameters::frequencies;
+	auto const frequencies = disscalc::optimize_timbre<disscalc::ProductModel>(
+		start,
+		intervals,
+		settings,
+		2
+	);
+	for (std::size_t i = 0; i < start.size(); ++i)
+	{
+		REQUIRE(frequencies.partials[i].amplitude == start[i].amplitude);
+	}
+}